@@ -1,6 +1,15 @@
 #include "Manager.h"
 
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace ClassProject {
+    /// Magic number at the beginning of binary BDD files, the last two characters are the format version
+    static const char BDD_FILE_MAGIC[8] = {'V', 'D', 'S', 'B', 'D', 'D', '0', '1'};
+
     Manager::Manager() {
         init_unique_table();
     }
@@ -51,6 +60,16 @@ namespace ClassProject {
         return val;
     }
 
+    /**
+     * Returns the ID that iteConstant reports for non-constant results. It never refers to a node.
+     *
+     * @return The ID representing a non-constant result
+     */
+    const BDD_ID &Manager::NonConstant() {
+        static const BDD_ID val = std::numeric_limits<BDD_ID>::max();
+        return val;
+    }
+
     /**
      * Returns true, if the given ID represents a leaf node.
      *
@@ -115,6 +134,235 @@ namespace ClassProject {
         return r;
     }
 
+    /**
+     * Decides whether ite(i, t, e) is a constant function without creating any node. The traversal aborts on the
+     * first pair of paths that evaluate differently.
+     *
+     * @param i Node (if)
+     * @param t Node (then)
+     * @param e Node (else)
+     * @return  True or False, if ite(i, t, e) is constant, NonConstant otherwise
+     */
+    BDD_ID Manager::iteConstant(BDD_ID i, BDD_ID t, BDD_ID e) { /* NOLINT */
+        // terminal case of recursion
+        if (i == True() || t == e) return isConstant(t) ? t : NonConstant();
+        if (i == False()) return isConstant(e) ? e : NonConstant();
+        if (isConstant(t) && isConstant(e)) return NonConstant();   // i or ~i
+        auto &table = tagged_computed_table[ITE_CONSTANT];
+        if (auto search = table.find(hashFunction(i, t, e)); search != table.end()) {
+            return search->second;
+        }
+        // let x be the top-variable of (i, t, e)
+        BDD_ID x = topVar(i);
+        if (topVar(t) < x && !isConstant(t)) x = topVar(t);
+        if (topVar(e) < x && !isConstant(e)) x = topVar(e);
+
+        // co-factors with regards to the top-variable are successors and do not create nodes
+        BDD_ID r = iteConstant(coFactorTrue(i, x), coFactorTrue(t, x), coFactorTrue(e, x));
+        if (r != NonConstant() && r != iteConstant(coFactorFalse(i, x), coFactorFalse(t, x), coFactorFalse(e, x)))
+            r = NonConstant();
+        table.insert({hashFunction(i, t, e), r});
+        return r;
+    }
+
+    /**
+     * Returns true, if f implies g, i.e. ite(f, g, 1) is constant True. No node is created.
+     *
+     * @param f Function represented by ID
+     * @param g Function represented by ID
+     * @return  Returns true, if f <= g
+     */
+    bool Manager::leq(BDD_ID f, BDD_ID g) {
+        return iteConstant(f, g, True()) == True();
+    }
+
+    /**
+     * Computes the generalized co-factor of f with regards to the care set c (Coudert and Madre). The result agrees
+     * with f wherever c is true, i.e. constrain(f, c) * c == f * c.
+     *
+     * @param f Function represented by ID
+     * @param c Care set represented by ID
+     * @return  The generalized co-factor
+     */
+    BDD_ID Manager::constrain(BDD_ID f, BDD_ID c) { /* NOLINT */
+        // terminal case of recursion
+        if (c == True() || isConstant(f)) return f;
+        if (c == False()) return False();
+        if (f == c) return True();
+        auto &table = tagged_computed_table[CONSTRAIN];
+        if (auto search = table.find(hashFunction(f, c, False())); search != table.end()) {
+            return search->second;
+        }
+        // let x be the top-variable of (f, c)
+        BDD_ID x = topVar(f);
+        if (topVar(c) < x) x = topVar(c);
+
+        BDD_ID c_high = coFactorTrue(c, x);
+        BDD_ID c_low = coFactorFalse(c, x);
+        BDD_ID r;
+        if (c_high == False()) {
+            r = constrain(coFactorFalse(f, x), c_low);
+        } else if (c_low == False()) {
+            r = constrain(coFactorTrue(f, x), c_high);
+        } else {
+            BDD_ID r_high = constrain(coFactorTrue(f, x), c_high);
+            BDD_ID r_low = constrain(coFactorFalse(f, x), c_low);
+            r = r_high == r_low ? r_high : find_or_add_unique_table(x, r_high, r_low);
+        }
+        table.insert({hashFunction(f, c, False()), r});
+        return r;
+    }
+
+    /**
+     * Simplifies f with regards to the care set c. Like constrain, the result agrees with f wherever c is true,
+     * but variables of c that f does not depend on are quantified, so the result never depends on variables outside
+     * the support of f.
+     *
+     * @param f Function represented by ID
+     * @param c Care set represented by ID
+     * @return  The restricted function
+     */
+    BDD_ID Manager::restrict(BDD_ID f, BDD_ID c) { /* NOLINT */
+        // terminal case of recursion
+        if (c == True() || isConstant(f)) return f;
+        if (c == False()) return False();
+        if (f == c) return True();
+        auto &table = tagged_computed_table[RESTRICT];
+        if (auto search = table.find(hashFunction(f, c, False())); search != table.end()) {
+            return search->second;
+        }
+        BDD_ID r;
+        BDD_ID x = topVar(f);
+        if (topVar(c) < x) {
+            // f does not depend on the top-variable of c
+            r = restrict(f, or2(coFactorTrue(c), coFactorFalse(c)));
+        } else {
+            BDD_ID c_high = coFactorTrue(c, x);
+            BDD_ID c_low = coFactorFalse(c, x);
+            if (c_high == False()) {
+                r = restrict(coFactorFalse(f), c_low);
+            } else if (c_low == False()) {
+                r = restrict(coFactorTrue(f), c_high);
+            } else {
+                BDD_ID r_high = restrict(coFactorTrue(f), c_high);
+                BDD_ID r_low = restrict(coFactorFalse(f), c_low);
+                r = r_high == r_low ? r_high : find_or_add_unique_table(x, r_high, r_low);
+            }
+        }
+        table.insert({hashFunction(f, c, False()), r});
+        return r;
+    }
+
+    /**
+     * Returns an under-approximation of f with at most threshold nodes (including the terminal nodes) by
+     * following the heavy branch, i.e. the successor with more satisfying assignments, from the root until the
+     * remaining sub-graph fits into the threshold. Light branches along the path are kept if the result still
+     * fits, otherwise they are replaced by False. A satisfiable f never yields False: if the heavy path reaches
+     * True before it fits, this path is kept and the result has its length plus two nodes, even if that is
+     * more than threshold.
+     *
+     * @param f         Function represented by ID
+     * @param threshold Maximum number of nodes of the result
+     * @return          A subset of f
+     */
+    BDD_ID Manager::subsetHeavyBranch(BDD_ID f, size_t threshold) {
+        if (f >= uniqueTableSize())
+            throw std::runtime_error("Invalid BDD ID.");
+        std::set<BDD_ID> nodes;
+        std::unordered_map<BDD_ID, double> density;
+        std::vector<std::pair<BDD_ID, bool>> path;  // node and whether its heavy branch is the high successor
+
+        BDD_ID n = f;
+        findNodes(n, nodes);
+        while (!isConstant(n) && path.size() + nodes.size() > threshold) {
+            bool heavy_high = satDensity(coFactorTrue(n), density) >= satDensity(coFactorFalse(n), density);
+            path.emplace_back(n, heavy_high);
+            n = heavy_high ? coFactorTrue(n) : coFactorFalse(n);
+            nodes.clear();
+            findNodes(n, nodes);
+        }
+
+        // rebuild the path bottom-up on top of the remaining sub-graph, light branches are kept if they still fit
+        BDD_ID r = n;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            BDD_ID x = topVar(it->first);
+            BDD_ID light = it->second ? coFactorFalse(it->first) : coFactorTrue(it->first);
+            BDD_ID with_light = r == light ? r
+                                           : it->second ? find_or_add_unique_table(x, r, light)
+                                                        : find_or_add_unique_table(x, light, r);
+            nodes.clear();
+            findNodes(with_light, nodes);
+            size_t nodes_above = static_cast<size_t>(path.rend() - it) - 1;
+            if (nodes.size() + nodes_above <= threshold)
+                r = with_light;
+            else if (r != False())
+                r = it->second ? find_or_add_unique_table(x, r, False()) : find_or_add_unique_table(x, False(), r);
+        }
+        return r;
+    }
+
+    /**
+     * Returns an under-approximation of f with at most threshold nodes (including the terminal nodes) that keeps
+     * the nodes lying on the shortest paths to True. At least one shortest path is kept, even if it exceeds the
+     * threshold.
+     *
+     * @param f         Function represented by ID
+     * @param threshold Maximum number of nodes of the result
+     * @return          A subset of f
+     */
+    BDD_ID Manager::subsetShortPaths(BDD_ID f, size_t threshold) {
+        if (f >= uniqueTableSize())
+            throw std::runtime_error("Invalid BDD ID.");
+        std::set<BDD_ID> nodes;
+        findNodes(f, nodes);
+        if (isConstant(f) || nodes.size() <= threshold)
+            return f;
+
+        std::unordered_map<BDD_ID, size_t> distance;
+        shortestPathLength(f, distance);
+        // successors always have smaller IDs than their predecessors, so descending IDs are a topological order
+        std::unordered_map<BDD_ID, size_t> depth = {{f, 0}};
+        std::vector<size_t> lengths;
+        for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+            if (isConstant(*it))
+                continue;
+            size_t d = depth.at(*it);
+            lengths.push_back(d + distance.at(*it));
+            for (BDD_ID child: {coFactorTrue(*it), coFactorFalse(*it)}) {
+                if (auto search = depth.find(child); search == depth.end() || search->second > d + 1)
+                    depth[child] = d + 1;
+            }
+        }
+
+        // choose the largest path length whose nodes fit into the threshold besides the terminal nodes
+        std::sort(lengths.begin(), lengths.end());
+        size_t budget = threshold > 2 ? threshold - 2 : 0;
+        size_t length = budget < lengths.size() ? lengths[budget] - 1 : lengths.back();
+        if (length < lengths.front())
+            length = lengths.front();
+
+        std::unordered_map<BDD_ID, BDD_ID> memo;
+        BDD_ID r = subsetPaths(f, length, depth, distance, memo);
+        nodes.clear();
+        findNodes(r, nodes);
+        if (nodes.size() <= threshold)
+            return r;
+
+        // the shortest paths alone exceed the threshold, keep a single one of them
+        std::vector<std::pair<BDD_ID, bool>> path;
+        for (BDD_ID n = f; !isConstant(n);) {
+            bool high = distance.at(coFactorTrue(n)) <= distance.at(coFactorFalse(n));
+            path.emplace_back(n, high);
+            n = high ? coFactorTrue(n) : coFactorFalse(n);
+        }
+        r = True();
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            BDD_ID x = topVar(it->first);
+            r = it->second ? find_or_add_unique_table(x, r, False()) : find_or_add_unique_table(x, False(), r);
+        }
+        return r;
+    }
+
     /**
      * Returns the positive co-factor of the function represented by ID f with regards to variable x.
      *
@@ -321,6 +569,374 @@ namespace ClassProject {
         File.close();
     }
 
+    /**
+     * Returns the exact number of satisfying assignments of f over a domain of nvars variables. The support of f has
+     * to be contained in the domain, i.e. nvars must not be smaller than the number of variables f depends on.
+     *
+     * @param f     Function represented by ID
+     * @param nvars Number of variables of the domain
+     * @return      The number of satisfying assignments
+     * @throws std::runtime_error if nvars is smaller than the support of f
+     */
+    BigCount Manager::satCount(BDD_ID f, size_t nvars) {
+        checkSatCountDomain(f, nvars);
+        std::unordered_map<BDD_ID, BigCount> memo;
+        BigCount total = BigCount(1) << nvars;
+        return satCountRec(f, total, memo);
+    }
+
+    /**
+     * Returns the number of satisfying assignments of f over a domain of nvars variables as floating point number.
+     * The result is infinite if it exceeds the range of double.
+     *
+     * @param f     Function represented by ID
+     * @param nvars Number of variables of the domain
+     * @return      The approximate number of satisfying assignments
+     * @throws std::runtime_error if nvars is smaller than the support of f
+     */
+    double Manager::satCountDouble(BDD_ID f, size_t nvars) {
+        checkSatCountDomain(f, nvars);
+        std::unordered_map<BDD_ID, double> memo;
+        return std::ldexp(satDensity(f, memo), static_cast<int>(nvars));
+    }
+
+    /**
+     * Returns the binary logarithm of the number of satisfying assignments of f over a domain of nvars variables.
+     * Unlike satCountDouble, the result does not overflow for large domains. Returns -infinity if f is False.
+     *
+     * @param f     Function represented by ID
+     * @param nvars Number of variables of the domain
+     * @return      The binary logarithm of the number of satisfying assignments
+     * @throws std::runtime_error if nvars is smaller than the support of f
+     */
+    double Manager::satCountLog2(BDD_ID f, size_t nvars) {
+        checkSatCountDomain(f, nvars);
+        std::unordered_map<BDD_ID, double> memo;
+        return static_cast<double>(nvars) + satDensityLog2(f, memo);
+    }
+
+    /**
+     * Returns one cube (path to True) of f. Variables of vars that do not lie on the path are set to CUBE_DONT_CARE.
+     *
+     * @param f     Function represented by ID
+     * @param vars  Variables of the cube, has to contain the support of f
+     * @return      A cube of f with one entry per variable of vars
+     * @throws std::runtime_error if f is False or vars does not contain the support of f
+     */
+    Cube Manager::pickOneCube(BDD_ID f, const std::vector<BDD_ID> &vars) {
+        CubeIterator it(*this, f, vars);
+        if (!it.next())
+            throw std::runtime_error("Function is not satisfiable.");
+        return it.cube();
+    }
+
+    /**
+     * Returns one satisfying assignment of f. Don't care variables of the picked cube are set to false.
+     *
+     * @param f     Function represented by ID
+     * @param vars  Variables of the assignment, has to contain the support of f
+     * @return      A satisfying assignment with one entry per variable of vars
+     * @throws std::runtime_error if f is False or vars does not contain the support of f
+     */
+    std::vector<bool> Manager::pickOneMinterm(BDD_ID f, const std::vector<BDD_ID> &vars) {
+        Cube cube = pickOneCube(f, vars);
+        std::vector<bool> minterm(cube.size());
+        for (size_t i = 0; i < cube.size(); i++)
+            minterm[i] = cube[i] == 1;
+        return minterm;
+    }
+
+    /**
+     * Writes all cubes of f to the given stream, one cube per line with one character ('0', '1' or '-') per
+     * variable of vars. The cubes are enumerated lazily and are not kept in memory.
+     *
+     * @param f     Function represented by ID
+     * @param vars  Variables of the cubes, has to contain the support of f
+     * @param out   Output stream
+     * @return      The number of cubes written
+     * @throws std::runtime_error if vars does not contain the support of f
+     */
+    size_t Manager::dumpCubes(BDD_ID f, const std::vector<BDD_ID> &vars, std::ostream &out) {
+        static const char symbols[] = {'0', '1', '-'};
+        std::string line(vars.size() + 1, '\n');
+        size_t count = 0;
+        for (CubeIterator it(*this, f, vars); it.next(); count++) {
+            const Cube &cube = it.cube();
+            for (size_t i = 0; i < cube.size(); i++)
+                line[i] = symbols[cube[i]];
+            out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        }
+        return count;
+    }
+
+    /**
+     * Returns the ADD terminal with the given value.
+     *
+     * @param value Value of the terminal
+     * @return      ID of the terminal
+     */
+    ADD_ID Manager::addConstant(ADD_Value value) {
+        if (auto search = add_terminal_map.find(value); search != add_terminal_map.end())
+            return search->second;
+        ADD_ID id = add_table.size();
+        add_table.push_back({.topVar=ADD_TERMINAL, .high=id, .low=id, .value=value});
+        add_terminal_map.emplace(value, id);
+        return id;
+    }
+
+    /**
+     * Selects between two ADDs by a BDD: the result equals g for all assignments that satisfy f, and h otherwise.
+     * Folding a sequence of disjoint BDDs with addIte labels each of them with a value.
+     *
+     * @param f Condition (BDD)
+     * @param g ADD for assignments that satisfy f
+     * @param h ADD for all other assignments
+     * @return  ID of the resulting ADD
+     * @throws std::runtime_error if f is no valid BDD or g or h are no valid ADDs
+     */
+    ADD_ID Manager::addIte(BDD_ID f, ADD_ID g, ADD_ID h) { /* NOLINT */
+        if (f >= uniqueTableSize())
+            throw std::runtime_error("Invalid BDD ID.");
+        checkAddId(g);
+        checkAddId(h);
+        // terminal cases
+        if (f == True() || g == h) return g;
+        if (f == False()) return h;
+        if (auto search = add_computed_table.find(hashFunction(f, g, h)); search != add_computed_table.end())
+            return search->second;
+
+        BDD_ID x = std::min({topVar(f), add_table[g].topVar, add_table[h].topVar});
+        ADD_ID gT = add_table[g].topVar == x ? add_table[g].high : g;
+        ADD_ID gF = add_table[g].topVar == x ? add_table[g].low : g;
+        ADD_ID hT = add_table[h].topVar == x ? add_table[h].high : h;
+        ADD_ID hF = add_table[h].topVar == x ? add_table[h].low : h;
+        ADD_ID high = addIte(coFactorTrue(f, x), gT, hT);
+        ADD_ID low = addIte(coFactorFalse(f, x), gF, hF);
+        ADD_ID r = high == low ? high : find_or_add_add_table(x, high, low);
+        add_computed_table.emplace(hashFunction(f, g, h), r);
+        return r;
+    }
+
+    /**
+     * Returns true, if f is an ADD terminal.
+     *
+     * @param f ADD
+     * @return  true, if f is a terminal
+     * @throws std::runtime_error if f is no valid ADD
+     */
+    bool Manager::addIsConstant(ADD_ID f) {
+        checkAddId(f);
+        return add_table[f].topVar == ADD_TERMINAL;
+    }
+
+    /**
+     * Returns the value of an ADD terminal.
+     *
+     * @param f ADD terminal
+     * @return  Value of the terminal
+     * @throws std::runtime_error if f is no valid ADD terminal
+     */
+    ADD_Value Manager::addValue(ADD_ID f) {
+        if (!addIsConstant(f))
+            throw std::runtime_error("ADD is not a terminal.");
+        return add_table[f].value;
+    }
+
+    /**
+     * Returns the top variable of an ADD, ADD_TERMINAL for terminals.
+     *
+     * @param f ADD
+     * @return  Top variable
+     * @throws std::runtime_error if f is no valid ADD
+     */
+    BDD_ID Manager::addTopVar(ADD_ID f) {
+        checkAddId(f);
+        return add_table[f].topVar;
+    }
+
+    /**
+     * Returns the high successor of an ADD, terminals are their own successors.
+     *
+     * @param f ADD
+     * @return  High successor
+     * @throws std::runtime_error if f is no valid ADD
+     */
+    ADD_ID Manager::addCoFactorTrue(ADD_ID f) {
+        checkAddId(f);
+        return add_table[f].high;
+    }
+
+    /**
+     * Returns the low successor of an ADD, terminals are their own successors.
+     *
+     * @param f ADD
+     * @return  Low successor
+     * @throws std::runtime_error if f is no valid ADD
+     */
+    ADD_ID Manager::addCoFactorFalse(ADD_ID f) {
+        checkAddId(f);
+        return add_table[f].low;
+    }
+
+    /**
+     * Evaluates an ADD for an assignment by a single walk from the root to a terminal.
+     *
+     * @param f         ADD
+     * @param vars      Variables of the assignment in the variable order, has to contain the support of f
+     * @param values    Value of each variable of vars
+     * @return          Value of the reached terminal
+     * @throws std::runtime_error if f is no valid ADD, the sizes of vars and values differ or vars does not contain
+     *                            the support of f
+     */
+    ADD_Value Manager::addEvaluate(ADD_ID f, const std::vector<BDD_ID> &vars, const std::vector<bool> &values) {
+        checkAddId(f);
+        if (vars.size() != values.size())
+            throw std::runtime_error("Number of variables and values do not match.");
+        size_t i = 0;
+        while (add_table[f].topVar != ADD_TERMINAL) {
+            // skip variables f does not depend on
+            while (i < vars.size() && vars[i] < add_table[f].topVar)
+                i++;
+            if (i == vars.size() || vars[i] != add_table[f].topVar)
+                throw std::runtime_error("Variables do not contain the support of the ADD.");
+            f = values[i] ? add_table[f].high : add_table[f].low;
+        }
+        return add_table[f].value;
+    }
+
+    /**
+     * Returns the number of assignments that lead to each terminal of an ADD over a domain of nvars variables.
+     *
+     * @param f     ADD
+     * @param nvars Number of variables of the domain
+     * @return      Number of assignments per terminal value
+     * @throws std::runtime_error if f is no valid ADD or nvars is smaller than the support of f
+     */
+    std::map<ADD_Value, BigCount> Manager::addTerminalCounts(ADD_ID f, size_t nvars) {
+        checkAddId(f);
+        // collect the support of f, as checkSatCountDomain does for BDDs
+        std::set<ADD_ID> visited;
+        std::set<BDD_ID> vars;
+        std::vector<ADD_ID> stack = {f};
+        while (!stack.empty()) {
+            ADD_ID node = stack.back();
+            stack.pop_back();
+            if (add_table[node].topVar == ADD_TERMINAL || !visited.insert(node).second)
+                continue;
+            vars.insert(add_table[node].topVar);
+            stack.push_back(add_table[node].high);
+            stack.push_back(add_table[node].low);
+        }
+        if (vars.size() > nvars)
+            throw std::runtime_error("Number of variables is smaller than the support of the ADD.");
+
+        std::unordered_map<ADD_ID, std::map<ADD_Value, BigCount>> memo;
+        BigCount total = BigCount(1) << nvars;
+        return addTerminalCountsRec(f, total, memo);
+    }
+
+    /**
+     * Returns the number of ADD nodes, including the terminals.
+     *
+     * @return Size of the ADD table
+     */
+    size_t Manager::addTableSize() {
+        return add_table.size();
+    }
+
+    /**
+     * Writes a set of named roots to a binary file. The file contains the labels of the variables in the variable
+     * order, followed by all nodes of the roots in topological order (children first) and the roots. Each node
+     * refers to its variable by index and to its children by the distance to their index, all numbers are encoded as
+     * LEB128 varints.
+     *
+     * @param roots Roots to save, by name
+     * @param path  Path of the file
+     * @throws std::runtime_error if a root is no valid BDD or the file cannot be written
+     */
+    void Manager::save(const std::map<std::string, BDD_ID> &roots, const std::string &path) {
+        std::set<BDD_ID> nodes;
+        for (const auto &[name, root]: roots) {
+            if (root >= uniqueTableSize())
+                throw std::runtime_error("Invalid BDD ID.");
+            findNodes(root, nodes);
+        }
+        // children have smaller IDs than their parents, so the nodes are in topological order
+        std::vector<BDD_ID> internal;
+        std::set<BDD_ID> vars;
+        for (BDD_ID node: nodes) {
+            if (!isConstant(node)) {
+                internal.push_back(node);
+                vars.insert(topVar(node));
+            }
+        }
+
+        std::string out(BDD_FILE_MAGIC, sizeof(BDD_FILE_MAGIC));
+        std::unordered_map<BDD_ID, uint64_t> var_index;
+        writeVarint(out, vars.size());
+        for (BDD_ID var: vars) {
+            var_index.emplace(var, var_index.size());
+            writeVarint(out, unique_table[var].label.size());
+            out += unique_table[var].label;
+        }
+        std::unordered_map<BDD_ID, uint64_t> node_index = {{False(), 0}, {True(), 1}};
+        writeVarint(out, internal.size());
+        for (BDD_ID node: internal) {
+            uint64_t index = node_index.size();
+            writeVarint(out, var_index.at(topVar(node)));
+            writeVarint(out, index - node_index.at(coFactorTrue(node)));
+            writeVarint(out, index - node_index.at(coFactorFalse(node)));
+            node_index.emplace(node, index);
+        }
+        writeVarint(out, roots.size());
+        for (const auto &[name, root]: roots) {
+            writeVarint(out, name.size());
+            out += name;
+            writeVarint(out, node_index.at(root));
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.write(out.data(), static_cast<std::streamsize>(out.size())))
+            throw std::runtime_error("Unable to write BDD file " + path + ".");
+    }
+
+    /**
+     * Loads the named roots of a binary file written by save. The file is memory-mapped and the nodes are added in a
+     * single pass. Variables are matched by label to variables of the manager that were not matched before, missing
+     * variables are created. If the matched variables are in a different order than in the file, the nodes are
+     * rebuilt with ite.
+     *
+     * @param path  Path of the file
+     * @return      Loaded roots, by name
+     * @throws std::runtime_error if the file cannot be read or is no valid BDD file
+     */
+    std::map<std::string, BDD_ID> Manager::load(const std::string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Unable to open BDD file " + path + ".");
+        struct stat st = {};
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(BDD_FILE_MAGIC))) {
+            close(fd);
+            throw std::runtime_error("Invalid BDD file " + path + ".");
+        }
+        size_t size = st.st_size;
+        void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+            throw std::runtime_error("Unable to map BDD file " + path + ".");
+
+        std::map<std::string, BDD_ID> roots;
+        try {
+            const auto *begin = static_cast<const uint8_t *>(data);
+            roots = loadBuffer(begin, begin + size);
+        } catch (...) {
+            munmap(data, size);
+            throw;
+        }
+        munmap(data, size);
+        return roots;
+    }
+
     /**
      * Find or add unique table and eliminate isomorphic sub-graphs
      *
@@ -341,6 +957,154 @@ namespace ClassProject {
         return id;
     }
 
+    /**
+     * Find or add an internal node to the ADD table
+     *
+     * @param x     Variable
+     * @param high  High successor
+     * @param low   Low successor
+     * @return      ID of the ADD node
+     */
+    ADD_ID Manager::find_or_add_add_table(BDD_ID x, ADD_ID high, ADD_ID low) {
+        if (auto search = add_table_map.find(hashFunction(x, high, low)); search != add_table_map.end())
+            return search->second;
+        ADD_ID id = add_table.size();
+        add_table.push_back({.topVar=x, .high=high, .low=low, .value=0});
+        add_table_map.emplace(hashFunction(x, high, low), id);
+        return id;
+    }
+
+    /**
+     * Checks that f is a node of the ADD table
+     *
+     * @param f ADD
+     * @throws std::runtime_error if f is no valid ADD
+     */
+    void Manager::checkAddId(ADD_ID f) {
+        if (f >= add_table.size())
+            throw std::runtime_error("Invalid ADD ID.");
+    }
+
+    /**
+     * Appends a number to a string as LEB128 varint
+     *
+     * @param out   Output
+     * @param value Number
+     */
+    void Manager::writeVarint(std::string &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    /**
+     * Reads a LEB128 varint and advances the position behind it
+     *
+     * @param pos   Position in the buffer
+     * @param end   End of the buffer
+     * @return      Number
+     * @throws std::runtime_error if the buffer ends within the varint
+     */
+    uint64_t Manager::readVarint(const uint8_t *&pos, const uint8_t *end) {
+        uint64_t value = 0;
+        for (unsigned int shift = 0; pos < end && shift < 64; shift += 7) {
+            uint8_t byte = *pos++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        throw std::runtime_error("Invalid BDD file, truncated number.");
+    }
+
+    /**
+     * Reads a string prefixed by its length and advances the position behind it
+     *
+     * @param pos   Position in the buffer
+     * @param end   End of the buffer
+     * @return      String
+     * @throws std::runtime_error if the buffer ends within the string
+     */
+    std::string Manager::readString(const uint8_t *&pos, const uint8_t *end) {
+        uint64_t length = readVarint(pos, end);
+        if (length > static_cast<uint64_t>(end - pos))
+            throw std::runtime_error("Invalid BDD file, truncated string.");
+        std::string str(reinterpret_cast<const char *>(pos), length);
+        pos += length;
+        return str;
+    }
+
+    /**
+     * Adds the nodes of a binary BDD file to the unique table, see save for the format
+     *
+     * @param pos   Beginning of the file content
+     * @param end   End of the file content
+     * @return      Loaded roots, by name
+     * @throws std::runtime_error if the content is no valid BDD file
+     */
+    std::map<std::string, BDD_ID> Manager::loadBuffer(const uint8_t *pos, const uint8_t *end) {
+        if (end - pos < static_cast<std::ptrdiff_t>(sizeof(BDD_FILE_MAGIC)) ||
+            std::memcmp(pos, BDD_FILE_MAGIC, sizeof(BDD_FILE_MAGIC)) != 0)
+            throw std::runtime_error("Invalid BDD file, unknown format.");
+        pos += sizeof(BDD_FILE_MAGIC);
+
+        // match variables by label, in the order of the variables of the manager
+        std::unordered_map<std::string, std::vector<BDD_ID>> existing;
+        for (BDD_ID id = uniqueTableSize(); id-- > True() + 1;) {
+            if (isVariable(id))
+                existing[unique_table[id].label].push_back(id);
+        }
+        uint64_t var_count = readVarint(pos, end);
+        std::vector<BDD_ID> vars;
+        bool ordered = true;
+        for (uint64_t i = 0; i < var_count; i++) {
+            std::string label = readString(pos, end);
+            auto search = existing.find(label);
+            if (search != existing.end() && !search->second.empty()) {
+                vars.push_back(search->second.back());
+                search->second.pop_back();
+            } else {
+                vars.push_back(createVar(label));
+            }
+            ordered = ordered && (i == 0 || vars[i - 1] < vars[i]);
+        }
+
+        uint64_t node_count = readVarint(pos, end);
+        std::vector<BDD_ID> ids = {False(), True()};
+        ids.reserve(std::min<uint64_t>(node_count, static_cast<uint64_t>(end - pos) / 3) + 2);
+        for (uint64_t i = 0; i < node_count; i++) {
+            uint64_t index = ids.size();
+            uint64_t var = readVarint(pos, end);
+            uint64_t high = readVarint(pos, end);
+            uint64_t low = readVarint(pos, end);
+            if (var >= vars.size() || high == 0 || high > index || low == 0 || low > index)
+                throw std::runtime_error("Invalid BDD file, invalid node.");
+            BDD_ID x = vars[var], t = ids[index - high], e = ids[index - low];
+            if (ordered) {
+                // the file is reduced and ordered, the node can be added directly
+                if (t == e || (!isConstant(t) && topVar(t) <= x) || (!isConstant(e) && topVar(e) <= x))
+                    throw std::runtime_error("Invalid BDD file, node is not reduced or ordered.");
+                ids.push_back(find_or_add_unique_table(x, t, e));
+            } else {
+                ids.push_back(ite(x, t, e));
+            }
+        }
+
+        std::map<std::string, BDD_ID> roots;
+        uint64_t root_count = readVarint(pos, end);
+        for (uint64_t i = 0; i < root_count; i++) {
+            std::string name = readString(pos, end);
+            uint64_t index = readVarint(pos, end);
+            if (index >= ids.size())
+                throw std::runtime_error("Invalid BDD file, invalid root.");
+            roots[name] = ids[index];
+        }
+        if (pos != end)
+            throw std::runtime_error("Invalid BDD file, trailing data.");
+        return roots;
+    }
+
     /**
      * Prints a formatted unique table to std.
      */
@@ -426,4 +1190,224 @@ namespace ClassProject {
             }
         }
     }
-}
\ No newline at end of file
+
+    /**
+     * Counts the satisfying assignments of f. Since the low and high successor of a node do not depend on its top
+     * variable, both of their counts are even and count(f) = (count(high) + count(low)) / 2 is exact.
+     *
+     * @param f     Function represented by ID
+     * @param total Number of assignments of the domain (count of True)
+     * @param memo  Already counted nodes
+     * @return      The number of satisfying assignments
+     */
+    BigCount Manager::satCountRec(BDD_ID f, const BigCount &total, std::unordered_map<BDD_ID, BigCount> &memo) {  /* NOLINT */
+        if (f == False()) return 0;
+        if (f == True()) return total;
+        if (auto search = memo.find(f); search != memo.end())
+            return search->second;
+
+        BigCount count = (satCountRec(coFactorTrue(f), total, memo) + satCountRec(coFactorFalse(f), total, memo)) >> 1;
+        memo.emplace(f, count);
+        return count;
+    }
+
+    /**
+     * Returns the number of assignments that lead to each terminal of f.
+     *
+     * @param f     ADD
+     * @param total Number of all assignments
+     * @param memo  Already visited nodes
+     * @return      Number of assignments per terminal value
+     */
+    const std::map<ADD_Value, BigCount> &Manager::addTerminalCountsRec(   /* NOLINT */
+            ADD_ID f, const BigCount &total, std::unordered_map<ADD_ID, std::map<ADD_Value, BigCount>> &memo) {
+        if (auto search = memo.find(f); search != memo.end())
+            return search->second;
+
+        std::map<ADD_Value, BigCount> counts;
+        if (add_table[f].topVar == ADD_TERMINAL) {
+            counts.emplace(add_table[f].value, total);
+        } else {
+            // each successor covers half of the assignments
+            for (ADD_ID successor: {add_table[f].high, add_table[f].low}) {
+                for (const auto &[value, count]: addTerminalCountsRec(successor, total, memo))
+                    counts[value] += count >> 1;
+            }
+        }
+        return memo.emplace(f, std::move(counts)).first->second;
+    }
+
+    /**
+     * Returns the fraction of all assignments that satisfy f.
+     *
+     * @param f     Function represented by ID
+     * @param memo  Already visited nodes
+     * @return      Density of f in [0, 1]
+     */
+    double Manager::satDensity(BDD_ID f, std::unordered_map<BDD_ID, double> &memo) {  /* NOLINT */
+        if (f == False()) return 0.0;
+        if (f == True()) return 1.0;
+        if (auto search = memo.find(f); search != memo.end())
+            return search->second;
+
+        double density = (satDensity(coFactorTrue(f), memo) + satDensity(coFactorFalse(f), memo)) / 2.0;
+        memo.emplace(f, density);
+        return density;
+    }
+
+    /**
+     * Returns the binary logarithm of the density of f. The sum of the successor densities is computed in the
+     * logarithmic domain, so deep BDDs do not underflow to zero.
+     *
+     * @param f     Function represented by ID
+     * @param memo  Already visited nodes
+     * @return      Binary logarithm of the density of f, -infinity for False
+     */
+    double Manager::satDensityLog2(BDD_ID f, std::unordered_map<BDD_ID, double> &memo) {  /* NOLINT */
+        if (f == False()) return -std::numeric_limits<double>::infinity();
+        if (f == True()) return 0.0;
+        if (auto search = memo.find(f); search != memo.end())
+            return search->second;
+
+        double high = satDensityLog2(coFactorTrue(f), memo);
+        double low = satDensityLog2(coFactorFalse(f), memo);
+        double max = std::max(high, low);
+        double min = std::min(high, low);
+        // log2((2^high + 2^low) / 2)
+        double density = max + std::log2(1.0 + std::exp2(min - max)) - 1.0;
+        memo.emplace(f, density);
+        return density;
+    }
+
+    /**
+     * Checks that f only depends on variables of a domain with nvars variables.
+     *
+     * @param f     Function represented by ID
+     * @param nvars Number of variables of the domain
+     * @throws std::runtime_error if nvars is smaller than the support of f
+     */
+    void Manager::checkSatCountDomain(BDD_ID f, size_t nvars) {
+        if (f >= uniqueTableSize())
+            throw std::runtime_error("Invalid BDD ID.");
+        std::set<BDD_ID> vars;
+        findVars(f, vars);
+        if (vars.size() > nvars)
+            throw std::runtime_error("Number of variables is smaller than the support of the function.");
+    }
+
+    /**
+     * Returns the number of edges of the shortest path from f to True, the maximum value of size_t if f is False.
+     *
+     * @param f     Function represented by ID
+     * @param memo  Lengths of already visited nodes
+     * @return      Length of the shortest path to True
+     */
+    size_t Manager::shortestPathLength(BDD_ID f, std::unordered_map<BDD_ID, size_t> &memo) {   /* NOLINT */
+        if (f == True()) return memo[f] = 0;
+        if (f == False()) return memo[f] = std::numeric_limits<size_t>::max();
+        if (auto search = memo.find(f); search != memo.end())
+            return search->second;
+
+        size_t length = std::min(shortestPathLength(coFactorTrue(f), memo),
+                                 shortestPathLength(coFactorFalse(f), memo));
+        memo.emplace(f, length + 1);    // at least one successor has a path to True
+        return length + 1;
+    }
+
+    /**
+     * Rebuilds f with all nodes replaced by False that do not lie on a path of at most the given length.
+     *
+     * @param f         Function represented by ID
+     * @param length    Maximum path length
+     * @param depth     Shortest distance of each node from the root
+     * @param distance  Shortest distance of each node to True
+     * @param memo      Already rebuilt nodes
+     * @return          A subset of f
+     */
+    BDD_ID Manager::subsetPaths(BDD_ID f, size_t length, const std::unordered_map<BDD_ID, size_t> &depth, /* NOLINT */
+                                const std::unordered_map<BDD_ID, size_t> &distance,
+                                std::unordered_map<BDD_ID, BDD_ID> &memo) {
+        if (isConstant(f)) return f;
+        if (depth.at(f) + distance.at(f) > length) return False();
+        if (auto search = memo.find(f); search != memo.end())
+            return search->second;
+
+        BDD_ID r_high = subsetPaths(coFactorTrue(f), length, depth, distance, memo);
+        BDD_ID r_low = subsetPaths(coFactorFalse(f), length, depth, distance, memo);
+        BDD_ID r = r_high == r_low ? r_high : find_or_add_unique_table(topVar(f), r_high, r_low);
+        memo.emplace(f, r);
+        return r;
+    }
+
+    /**
+     * Creates an iterator over the cubes of f.
+     *
+     * @param manager   Manager owning f
+     * @param f         Function represented by ID
+     * @param vars      Variables of the cubes, has to contain the support of f
+     */
+    CubeIterator::CubeIterator(Manager &manager, BDD_ID f, const std::vector<BDD_ID> &vars)
+            : manager(manager), root(f), current(vars.size(), CUBE_DONT_CARE) {
+        if (f >= manager.uniqueTableSize())
+            throw std::runtime_error("Invalid BDD ID.");
+        for (size_t i = 0; i < vars.size(); i++)
+            position.emplace(vars[i], i);
+        path.reserve(vars.size() + 1);
+    }
+
+    /**
+     * Advances to the next cube.
+     *
+     * @return  Returns false, if all cubes have been enumerated
+     * @throws std::runtime_error if a variable on the path is not part of vars
+     */
+    bool CubeIterator::next() {
+        if (!started) {
+            started = true;
+            if (root == manager.False())
+                return false;
+            path.push_back({root, 0});
+        } else if (!path.empty()) {
+            path.pop_back();    // leave the True leaf of the last cube
+        }
+        return descend();
+    }
+
+    /**
+     * Returns the current cube. Only valid after next() returned true.
+     *
+     * @return The current cube
+     */
+    const Cube &CubeIterator::cube() const {
+        return current;
+    }
+
+    /**
+     * Continues the depth-first traversal from the top of the path stack until the next True leaf is reached.
+     *
+     * @return  Returns false, if the traversal is finished
+     */
+    bool CubeIterator::descend() {
+        while (!path.empty()) {
+            Frame &top = path.back();
+            if (top.node == manager.True())
+                return true;
+
+            auto pos = position.find(manager.topVar(top.node));
+            if (pos == position.end())
+                throw std::runtime_error("Variable of the function is missing in the cube variables.");
+            if (top.branch == 2) {   // both successors visited
+                current[pos->second] = CUBE_DONT_CARE;
+                path.pop_back();
+                continue;
+            }
+
+            BDD_ID child = top.branch == 0 ? manager.coFactorFalse(top.node) : manager.coFactorTrue(top.node);
+            current[pos->second] = top.branch;
+            top.branch++;
+            if (child != manager.False())
+                path.push_back({child, 0});
+        }
+        return false;
+    }
+}
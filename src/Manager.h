@@ -12,8 +12,52 @@
 #include <fstream>
 #include <iomanip>
 #include <unordered_map>
+#include <map>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <boost/multiprecision/cpp_int.hpp>
 
 namespace ClassProject {
+    typedef boost::multiprecision::cpp_int BigCount;
+
+    /// Assignment of a cube, one entry per variable: 0 (negative literal), 1 (positive literal) or CUBE_DONT_CARE
+    typedef std::vector<uint8_t> Cube;
+    static const uint8_t CUBE_DONT_CARE = 2;
+
+    class Manager;
+
+    /**
+     * Lazily enumerates the cubes (paths to True) of a BDD in depth-first order. The path is kept on an explicit
+     * stack, so no memory is allocated after construction and arbitrarily many cubes can be streamed.
+     *
+     * Usage: for (CubeIterator it(m, f, vars); it.next();) use(it.cube());
+     */
+    class CubeIterator {
+    private:
+        struct Frame {
+            BDD_ID node;
+            uint8_t branch;     ///< number of successors already visited (0: none, 1: low, 2: both)
+        };
+
+        Manager &manager;
+        BDD_ID root;
+        bool started = false;
+        std::vector<Frame> path;
+        Cube current;
+        std::unordered_map<BDD_ID, size_t> position;
+
+        bool descend();
+
+    public:
+        CubeIterator(Manager &manager, BDD_ID f, const std::vector<BDD_ID> &vars);
+
+        bool next();
+
+        const Cube &cube() const;
+    };
+
     struct uTableEntry {
         BDD_ID id;
         BDD_ID high;
@@ -22,12 +66,36 @@ namespace ClassProject {
         std::string label;
     };
 
+    /// Node of an algebraic decision diagram (ADD), a decision diagram with integer terminals
+    typedef size_t ADD_ID;
+    typedef int64_t ADD_Value;
+
+    struct addTableEntry {
+        BDD_ID topVar;      ///< Variable of the node, ADD_TERMINAL for terminals
+        ADD_ID high;
+        ADD_ID low;
+        ADD_Value value;    ///< Value of terminals
+    };
+    static const BDD_ID ADD_TERMINAL = std::numeric_limits<BDD_ID>::max();
+
     class Manager : public ManagerInterface {
     private:
         std::vector<uTableEntry> unique_table;
         std::unordered_map<size_t, BDD_ID> unique_table_map;
         std::unordered_map<size_t, BDD_ID> computed_table;
 
+        /// Operations besides ite that cache their results in a computed table of their own
+        enum ComputedTag {
+            ITE_CONSTANT, CONSTRAIN, RESTRICT, COMPUTED_TAG_COUNT
+        };
+        std::array<std::unordered_map<size_t, BDD_ID>, COMPUTED_TAG_COUNT> tagged_computed_table;
+
+        /// ADDs share the variables of the BDDs, but are kept in a table of their own
+        std::vector<addTableEntry> add_table;
+        std::unordered_map<size_t, ADD_ID> add_table_map;
+        std::unordered_map<ADD_Value, ADD_ID> add_terminal_map;
+        std::unordered_map<size_t, ADD_ID> add_computed_table;
+
         static size_t hashFunction(BDD_ID f, BDD_ID g, BDD_ID h);
 
         void init_unique_table();
@@ -40,6 +108,35 @@ namespace ClassProject {
 
         void standard_triples(BDD_ID *i, BDD_ID *t, BDD_ID *e);
 
+        BigCount satCountRec(BDD_ID f, const BigCount &total, std::unordered_map<BDD_ID, BigCount> &memo);
+
+        double satDensity(BDD_ID f, std::unordered_map<BDD_ID, double> &memo);
+
+        double satDensityLog2(BDD_ID f, std::unordered_map<BDD_ID, double> &memo);
+
+        void checkSatCountDomain(BDD_ID f, size_t nvars);
+
+        ADD_ID find_or_add_add_table(BDD_ID x, ADD_ID high, ADD_ID low);
+
+        void checkAddId(ADD_ID f);
+
+        static void writeVarint(std::string &out, uint64_t value);
+
+        static uint64_t readVarint(const uint8_t *&pos, const uint8_t *end);
+
+        static std::string readString(const uint8_t *&pos, const uint8_t *end);
+
+        std::map<std::string, BDD_ID> loadBuffer(const uint8_t *pos, const uint8_t *end);
+
+        const std::map<ADD_Value, BigCount> &addTerminalCountsRec(ADD_ID f, const BigCount &total,
+                                                                 std::unordered_map<ADD_ID, std::map<ADD_Value, BigCount>> &memo);
+
+        size_t shortestPathLength(BDD_ID f, std::unordered_map<BDD_ID, size_t> &memo);
+
+        BDD_ID subsetPaths(BDD_ID f, size_t length, const std::unordered_map<BDD_ID, size_t> &depth,
+                           const std::unordered_map<BDD_ID, size_t> &distance,
+                           std::unordered_map<BDD_ID, BDD_ID> &memo);
+
     public:
         Manager();
 
@@ -51,6 +148,8 @@ namespace ClassProject {
 
         const BDD_ID &False() override;
 
+        const BDD_ID &NonConstant();
+
         bool isConstant(BDD_ID f) override;
 
         bool isVariable(BDD_ID x) override;
@@ -59,6 +158,18 @@ namespace ClassProject {
 
         BDD_ID ite(BDD_ID i, BDD_ID t, BDD_ID e) override;
 
+        BDD_ID iteConstant(BDD_ID i, BDD_ID t, BDD_ID e);
+
+        bool leq(BDD_ID f, BDD_ID g);
+
+        BDD_ID constrain(BDD_ID f, BDD_ID c);
+
+        BDD_ID restrict(BDD_ID f, BDD_ID c);
+
+        BDD_ID subsetHeavyBranch(BDD_ID f, size_t threshold);
+
+        BDD_ID subsetShortPaths(BDD_ID f, size_t threshold);
+
         BDD_ID coFactorTrue(BDD_ID f, BDD_ID x) override;
 
         BDD_ID coFactorFalse(BDD_ID f, BDD_ID x) override;
@@ -90,6 +201,42 @@ namespace ClassProject {
         size_t uniqueTableSize() override;
 
         void visualizeBDD(std::string filepath, BDD_ID &root) override;
+
+        BigCount satCount(BDD_ID f, size_t nvars);
+
+        double satCountDouble(BDD_ID f, size_t nvars);
+
+        double satCountLog2(BDD_ID f, size_t nvars);
+
+        Cube pickOneCube(BDD_ID f, const std::vector<BDD_ID> &vars);
+
+        std::vector<bool> pickOneMinterm(BDD_ID f, const std::vector<BDD_ID> &vars);
+
+        size_t dumpCubes(BDD_ID f, const std::vector<BDD_ID> &vars, std::ostream &out);
+
+        ADD_ID addConstant(ADD_Value value);
+
+        ADD_ID addIte(BDD_ID f, ADD_ID g, ADD_ID h);
+
+        bool addIsConstant(ADD_ID f);
+
+        ADD_Value addValue(ADD_ID f);
+
+        BDD_ID addTopVar(ADD_ID f);
+
+        ADD_ID addCoFactorTrue(ADD_ID f);
+
+        ADD_ID addCoFactorFalse(ADD_ID f);
+
+        ADD_Value addEvaluate(ADD_ID f, const std::vector<BDD_ID> &vars, const std::vector<bool> &values);
+
+        std::map<ADD_Value, BigCount> addTerminalCounts(ADD_ID f, size_t nvars);
+
+        size_t addTableSize();
+
+        void save(const std::map<std::string, BDD_ID> &roots, const std::string &path);
+
+        std::map<std::string, BDD_ID> load(const std::string &path);
     };
 }
 
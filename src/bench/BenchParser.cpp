@@ -5,20 +5,96 @@
 
 #include "BenchParser.hpp"
 
-BenchParser::BenchParser(const std::string &bench_file) {
+#include <queue>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+gate_type_t ToGateType(const std::string &gate_type) {
+    if (gate_type == INPUT_GATE_T) return gate_type_t::Input;
+    if (gate_type == OUTPUT_GATE_T) return gate_type_t::Output;
+    if (gate_type == FLIP_FLOP_GATE_T) return gate_type_t::FlipFlop;
+    if (gate_type == BUFFER_GATE_T) return gate_type_t::Buffer;
+    if (gate_type == NOT_GATE_T) return gate_type_t::Not;
+    if (gate_type == AND_GATE_T) return gate_type_t::And;
+    if (gate_type == OR_GATE_T) return gate_type_t::Or;
+    if (gate_type == NAND_GATE_T) return gate_type_t::Nand;
+    if (gate_type == NOR_GATE_T) return gate_type_t::Nor;
+    if (gate_type == XOR_GATE_T) return gate_type_t::Xor;
+    throw std::runtime_error("Unsupported gate type " + gate_type + "!");
+}
+
+const char *GateTypeName(gate_type_t gate_type) {
+    switch (gate_type) {
+        case gate_type_t::Input: return INPUT_GATE_T;
+        case gate_type_t::Output: return OUTPUT_GATE_T;
+        case gate_type_t::FlipFlop: return FLIP_FLOP_GATE_T;
+        case gate_type_t::Buffer: return BUFFER_GATE_T;
+        case gate_type_t::Not: return NOT_GATE_T;
+        case gate_type_t::And: return AND_GATE_T;
+        case gate_type_t::Or: return OR_GATE_T;
+        case gate_type_t::Nand: return NAND_GATE_T;
+        case gate_type_t::Nor: return NOR_GATE_T;
+        case gate_type_t::Xor: return XOR_GATE_T;
+    }
+    throw std::runtime_error("Unsupported gate type!");
+}
+
+circuit_graph_t ToCircuitGraph(const list_of_circuit_t &circuit) {
+    circuit_graph_t graph;
+    std::unordered_map<unique_ID_t, size_t> id_to_position;
+    graph.fanin_offsets.push_back(0);
+    for (const auto &circuit_node : circuit) {
+        id_to_position.emplace(circuit_node.id, graph.size());
+        for (unique_ID_t input_id : circuit_node.input_id_list) {
+            auto input = id_to_position.find(input_id);
+            if (input == id_to_position.end())
+                throw std::runtime_error("The circuit must be topologically sorted!");
+            graph.fanin.push_back(input->second);
+        }
+        graph.fanin_offsets.push_back(graph.fanin.size());
+        graph.ids.push_back(circuit_node.id);
+        graph.labels.push_back(circuit_node.label);
+        graph.gate_types.push_back(ToGateType(circuit_node.gate_type));
+    }
+    return graph;
+}
+
+/* Converts a circuit graph back into a list of circuit nodes, the output lists stay empty */
+static list_of_circuit_t GraphToList(const circuit_graph_t &graph) {
+    list_of_circuit_t circuit;
+    for (size_t i = 0; i < graph.size(); i++) {
+        circuit_node_t circuit_node;
+        circuit_node.id = graph.ids[i];
+        circuit_node.label = graph.labels[i];
+        circuit_node.gate_type = GateTypeName(graph.gate_types[i]);
+        for (size_t j = graph.fanin_offsets[i]; j < graph.fanin_offsets[i + 1]; j++)
+            circuit_node.input_id_list.insert(graph.ids[graph.fanin[j]]);
+        circuit.push_back(std::move(circuit_node));
+    }
+    return circuit;
+}
+
+BenchParser::BenchParser(const std::string &bench_file, bool verbose, ParserBackend backend) : verbose(verbose) {
 
     id_counter = 0;
 
-    if (parseFile(bench_file)) {
+    if (backend == ParserBackend::MemoryMapped ? parseMappedFile(bench_file) : parseFile(bench_file)) {
         /* Based on the list of output labels, generate the corresponding circuit */
-        std::cout << "- Creating circuit from bench nodes... ";
+        if (verbose)
+            std::cout << "- Creating circuit from bench nodes... ";
         createCircuitFromOutputList();
-        std::cout << "Done!" << std::endl;
+        if (verbose)
+            std::cout << "Done!" << std::endl;
 
         /* Sort the circuit */
-        std::cout << "- Topologically sorting the circuit... ";
+        if (verbose)
+            std::cout << "- Topologically sorting the circuit... ";
         TopologicalSortKahnsAlgorithm();
-        std::cout << "Done!" << std::endl;
+        if (verbose)
+            std::cout << "Done!" << std::endl;
 
         label_to_node.clear();
         labels_to_id.clear();
@@ -205,22 +281,71 @@ std::unordered_map<unique_ID_t, circuit_node_t> BenchParser::GetCircuit() {
 }
 
 list_of_circuit_t BenchParser::GetSortedCircuit() {
+    return GraphToList(sorted_circuit);
+}
+
+list_of_circuit_t BenchParser::GetSortedCone(const std::set<label_t> &output_labels) {
+    return GraphToList(GetConeGraph(output_labels));
+}
+
+const circuit_graph_t &BenchParser::GetCircuitGraph() {
     return sorted_circuit;
 }
 
+circuit_graph_t BenchParser::GetConeGraph(const std::set<label_t> &output_labels) {
+    std::vector<size_t> stack;
+    for (size_t i = 0; i < sorted_circuit.size(); i++) {
+        gate_type_t gate_type = sorted_circuit.gate_types[i];
+        if (output_labels.count(sorted_circuit.labels[i]) != 0 && gate_type != gate_type_t::Output &&
+            gate_type != gate_type_t::FlipFlop)
+            stack.push_back(i);
+    }
+
+    /* Mark the transitive fan-in of the outputs */
+    std::vector<bool> in_cone(sorted_circuit.size(), false);
+    while (!stack.empty()) {
+        size_t node = stack.back();
+        stack.pop_back();
+        if (!in_cone[node]) {
+            in_cone[node] = true;
+            for (size_t j = sorted_circuit.fanin_offsets[node]; j < sorted_circuit.fanin_offsets[node + 1]; j++)
+                stack.push_back(sorted_circuit.fanin[j]);
+        }
+    }
+
+    /* Copy the marked nodes, keeping their order */
+    circuit_graph_t cone;
+    std::vector<size_t> position(sorted_circuit.size());
+    cone.fanin_offsets.push_back(0);
+    for (size_t i = 0; i < sorted_circuit.size(); i++) {
+        if (!in_cone[i])
+            continue;
+        position[i] = cone.size();
+        for (size_t j = sorted_circuit.fanin_offsets[i]; j < sorted_circuit.fanin_offsets[i + 1]; j++)
+            cone.fanin.push_back(position[sorted_circuit.fanin[j]]);
+        cone.fanin_offsets.push_back(cone.fanin.size());
+        cone.ids.push_back(sorted_circuit.ids[i]);
+        cone.labels.push_back(sorted_circuit.labels[i]);
+        cone.gate_types.push_back(sorted_circuit.gate_types[i]);
+    }
+    return cone;
+}
+
 /* --------------- 
  * Read File Functions 
  * ---------------
  */
 bool BenchParser::parseFile(const std::string &bench_file) {
 
-    std::cout << std::endl << "- Reading bench format file... ";
+    if (verbose)
+        std::cout << std::endl << "- Reading bench format file... ";
     std::ifstream in(bench_file);
     if (!in.is_open()) {
         throw std::runtime_error("Could not open file: " + bench_file);
     }
     in.unsetf(std::ios::skipws);
-    std::cout << "Done!" << std::endl;
+    if (verbose)
+        std::cout << "Done!" << std::endl;
 
     /* Declaring file iterators */
     boost::spirit::istream_iterator first(in), last;
@@ -235,7 +360,8 @@ bool BenchParser::parseFile(const std::string &bench_file) {
     bench_format::bench_node_type parsed_bench_node;
 
     /* Effectively parsing the file. The parser returns a benchnode to be added to the labels table */
-    std::cout << "- Parsing input file '" << bench_file << "'... ";
+    if (verbose)
+        std::cout << "- Parsing input file '" << bench_file << "'... ";
     bool successfully_parsed;
     do {
         successfully_parsed = phrase_parse(first, last, bench_grammar_parser, skip, parsed_bench_node);
@@ -244,15 +370,156 @@ bool BenchParser::parseFile(const std::string &bench_file) {
             return false;
         } else {
             /* Add the successfully read bench node into the labels table */
-            addToLabelTable(parsed_bench_node);
+            addToLabelTable(std::move(parsed_bench_node));
         }
         parsed_bench_node = bench_format::bench_node_type();
     } while (first != last); /* Operations are performed until it is EOF */
-    std::cout << "Done!" << std::endl;
+    if (verbose)
+        std::cout << "Done!" << std::endl;
 
     return true;
 }
 
+/* Tokenising helpers of the memory-mapped parser, they mirror the rules of bench_grammar.hpp */
+static void skipBlanks(std::string_view &text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        text.remove_prefix(1);
+}
+
+static bool consume(std::string_view &text, char c) {
+    skipBlanks(text);
+    if (text.empty() || text.front() != c)
+        return false;
+    text.remove_prefix(1);
+    return true;
+}
+
+static bool isLabelChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+}
+
+static std::string_view readLabel(std::string_view &text) {
+    skipBlanks(text);
+    size_t length = 0;
+    while (length < text.size() && isLabelChar(text[length]))
+        length++;
+    std::string_view label = text.substr(0, length);
+    text.remove_prefix(length);
+    return label;
+}
+
+/* Read-only mapping of a file, unmapped when it goes out of scope, also if parsing throws */
+class MappedFile {
+public:
+    MappedFile(void *data, size_t size) : data(data), size(size) {}
+    ~MappedFile() { munmap(data, size); }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    std::string_view Text() const { return {static_cast<const char *>(data), size}; }
+
+private:
+    void *data;
+    size_t size;
+};
+
+bool BenchParser::parseMappedFile(const std::string &bench_file) {
+
+    if (verbose)
+        std::cout << std::endl << "- Reading bench format file... ";
+    int fd = open(bench_file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + bench_file);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        std::cout << "Failed parsing input file: " << bench_file << " is empty" << std::endl;
+        return false;
+    }
+    auto size = static_cast<size_t>(st.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map file: " + bench_file);
+    }
+    MappedFile mapping(data, size);
+    madvise(data, size, MADV_SEQUENTIAL);
+    if (verbose)
+        std::cout << "Done!" << std::endl;
+
+    if (verbose)
+        std::cout << "- Parsing input file '" << bench_file << "'... ";
+    std::string_view text = mapping.Text();
+    bool successfully_parsed = true;
+    while (!text.empty() && successfully_parsed) {
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        successfully_parsed = parseLine(line);
+        if (!successfully_parsed)
+            std::cout << "Failed parsing input file at: " << line << std::endl;
+    }
+    if (successfully_parsed && verbose)
+        std::cout << "Done!" << std::endl;
+
+    return successfully_parsed;
+}
+
+bool BenchParser::parseLine(std::string_view line) {
+    if (size_t comment = line.find('#'); comment != std::string_view::npos)
+        line = line.substr(0, comment);
+    skipBlanks(line);
+    if (line.empty())
+        return true;
+
+    bench_node_t bench_node;
+    std::string_view first = readLabel(line);
+
+    /* Primary inputs and outputs */
+    if ((first == INPUT_GATE_T || first == OUTPUT_GATE_T) && consume(line, '(')) {
+        std::string_view label = readLabel(line);
+        if (label.empty() || !consume(line, ')'))
+            return false;
+        skipBlanks(line);
+        if (!line.empty())
+            return false;
+        bench_node.label = label;
+        bench_node.gate_type = first;
+        addToLabelTable(std::move(bench_node));
+        return true;
+    }
+
+    /* Gates */
+    if (first.empty() || !consume(line, '='))
+        return false;
+    std::string_view gate_type = readLabel(line);
+    bool single_input = gate_type == NOT_GATE_T || gate_type == BUFFER_GATE_T || gate_type == FLIP_FLOP_GATE_T;
+    bool multiple_input = gate_type == AND_GATE_T || gate_type == OR_GATE_T || gate_type == NAND_GATE_T ||
+                          gate_type == NOR_GATE_T || gate_type == XOR_GATE_T;
+    if ((!single_input && !multiple_input) || !consume(line, '('))
+        return false;
+    do {
+        std::string_view input = readLabel(line);
+        if (input.empty())
+            return false;
+        bench_node.input_node_list.emplace_back(input);
+    } while (consume(line, ','));
+    if (!consume(line, ')'))
+        return false;
+    skipBlanks(line);
+    if (!line.empty() || (single_input ? bench_node.input_node_list.size() != 1
+                                       : bench_node.input_node_list.size() < 2))
+        return false;
+
+    bench_node.label = first;
+    bench_node.gate_type = gate_type;
+    addToLabelTable(std::move(bench_node));
+    return true;
+}
+
 
 bool BenchParser::addToLabelTable(bench_node_t bench_node) {
     bool new_node_added;
@@ -294,7 +561,7 @@ bool BenchParser::addToLabelTable(bench_node_t bench_node) {
             bench_node.gate_type = INPUT_GATE_T;
             bench_node.input_node_list.clear();
         }
-        label_to_node.insert(std::pair<label_t, bench_node_t>(search_label, bench_node));
+        label_to_node.emplace(std::move(search_label), std::move(bench_node));
         new_node_added = true;
     }
     return new_node_added;
@@ -424,51 +691,49 @@ void BenchParser::createCircuitByLabel(const label_t &bnode_label) {
  * -----------------------------
  */
 void BenchParser::TopologicalSortKahnsAlgorithm() {
-    set_of_circuit_t nodes_without_outgoing_edges = GetListOfCircuitsOutputs();
-    set_of_circuit_t::iterator it;
+    /* Unique IDs are dense, so every table is an array indexed by them */
+    size_t node_count = id_counter;
+    std::vector<const circuit_node_t *> nodes(node_count, nullptr);
+    std::vector<size_t> outgoing_edges(node_count, 0);
+    for (const auto &entry : id_to_circuit_node) {
+        nodes[entry.first] = &entry.second;
+        outgoing_edges[entry.first] = entry.second.output_id_list.size();
+    }
 
-    circuit_node_t node, tmp_node;
+    std::priority_queue<unique_ID_t, std::vector<unique_ID_t>, std::greater<>> nodes_without_outgoing_edges(
+            std::greater<>(), std::vector<unique_ID_t>(output_circuits.begin(), output_circuits.end()));
 
+    /* Nodes are taken from the outputs backwards, so the order is reversed at the end */
+    std::vector<unique_ID_t> order;
+    order.reserve(node_count);
     while (!nodes_without_outgoing_edges.empty()) {
-        it = nodes_without_outgoing_edges.begin();
-        /* Always pick the first element of the list of nodes without incoming edges */
-        node = GetCircuitNode(*it);
-        nodes_without_outgoing_edges.erase(it);
-
-        /* Nodes are added always to the end of the list */
-        sorted_circuit.push_front(node);
-        for (auto it_input_nodes = node.input_id_list.begin();
-             it_input_nodes != node.input_id_list.end(); it_input_nodes++) {
-            if (IsUniqueOutgoingEdge(*it_input_nodes, node.id)) {
-                nodes_without_outgoing_edges.insert(*it_input_nodes);
-            }
+        unique_ID_t node = nodes_without_outgoing_edges.top();
+        nodes_without_outgoing_edges.pop();
+        order.push_back(node);
+        for (unique_ID_t input_id : nodes[node]->input_id_list) {
+            if (--outgoing_edges[input_id] == 0)
+                nodes_without_outgoing_edges.push(input_id);
         }
     }
 
-    if (sorted_circuit.size() != id_to_circuit_node.size()) {
+    if (order.size() != id_to_circuit_node.size()) {
         throw std::runtime_error("The circuit must be cycle free!");
     }
-}
 
-
-/* -----------------------------
- * Auxiliary functions for
- * Topological Sort Algorithms
- * -----------------------------
- */
-
-bool BenchParser::IsUniqueOutgoingEdge(unique_ID_t src_node, unique_ID_t dst_node) {
-    std::unordered_map<unique_ID_t, circuit_node_t>::iterator got;
-
-    /* Search source node in the circuit graph */
-    got = id_to_circuit_node.find(src_node);
-
-    if (got != id_to_circuit_node.end()) {
-        /* Remove outgoing edge to source node */
-        (got->second).output_id_list.erase((got->second).output_id_list.find(dst_node));
-        return (got->second).output_id_list.empty();
-    }//if
-    else {
-        throw std::runtime_error("Destination node UUID is not part of the circuit graph!");
+    std::vector<size_t> position(node_count);
+    sorted_circuit = circuit_graph_t();
+    sorted_circuit.ids.assign(order.rbegin(), order.rend());
+    sorted_circuit.labels.reserve(node_count);
+    sorted_circuit.gate_types.reserve(node_count);
+    sorted_circuit.fanin_offsets.reserve(node_count + 1);
+    sorted_circuit.fanin_offsets.push_back(0);
+    for (size_t i = 0; i < sorted_circuit.size(); i++) {
+        const circuit_node_t &circuit_node = *nodes[sorted_circuit.ids[i]];
+        position[circuit_node.id] = i;
+        for (unique_ID_t input_id : circuit_node.input_id_list)
+            sorted_circuit.fanin.push_back(position[input_id]);
+        sorted_circuit.fanin_offsets.push_back(sorted_circuit.fanin.size());
+        sorted_circuit.labels.push_back(circuit_node.label);
+        sorted_circuit.gate_types.push_back(ToGateType(circuit_node.gate_type));
     }
 }
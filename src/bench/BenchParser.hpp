@@ -13,6 +13,8 @@
 
 #include <unordered_map>
 #include <stdexcept>
+#include <vector>
+#include <string_view>
 
 #include "BenchmarkLib.h"
 
@@ -49,6 +51,67 @@ typedef struct circuit_node_t {
 
 typedef std::list<circuit_node_t> list_of_circuit_t; ///< Type definition for list of circuits
 
+/**
+ * \enum gate_type_t
+ * \brief Gate types of the bench format.
+ */
+enum class gate_type_t : uint8_t {
+    Input, Output, FlipFlop, Buffer, Not, And, Or, Nand, Nor, Xor
+};
+
+/**
+ * \brief converts the name of a gate type (ex. AND, NOT, OR) to its gate_type_t.
+ * \param gate_type is std::string
+ * \return gate_type_t
+ *
+ */
+gate_type_t ToGateType(const std::string &gate_type);
+
+/**
+ * \brief returns the name of a gate type (ex. AND, NOT, OR).
+ * \param gate_type is gate_type_t
+ * \return const char *
+ *
+ */
+const char *GateTypeName(gate_type_t gate_type);
+
+/**
+ * \struct circuit_graph_t
+ * \brief Topologically sorted circuit in compressed sparse row format.
+ *
+ *  Nodes are identified by their position in the topological order. The fan-in
+ *      of node i are the positions fanin[fanin_offsets[i]] to fanin[fanin_offsets[i+1]-1],
+ *      ordered by their circuit unique ID, and all of them are smaller than i.
+ */
+typedef struct circuit_graph_t {
+    std::vector<unique_ID_t> ids;      ///< Circuit unique ID of each node
+    std::vector<label_t> labels;       ///< Label of each node
+    std::vector<gate_type_t> gate_types; ///< Gate type of each node
+    std::vector<size_t> fanin_offsets; ///< Start of the fan-in of each node, with one extra entry at the end
+    std::vector<size_t> fanin;         ///< Positions of the fan-in nodes
+
+    size_t size() const { return ids.size(); }
+} circuit_graph_t;
+
+/**
+ * \brief converts a topologically sorted list of circuit nodes into a circuit graph.
+ * \param circuit is list_of_circuit_t
+ * \return circuit_graph_t
+ *
+ */
+circuit_graph_t ToCircuitGraph(const list_of_circuit_t &circuit);
+
+/**
+ * \enum ParserBackend
+ * \brief Selects how BenchParser reads the bench file.
+ *
+ *  Both backends accept the same bench format and produce the same circuit.
+ */
+enum class ParserBackend {
+    Spirit,      ///< Boost.Spirit grammar reading through a stream iterator
+    MemoryMapped ///< Hand-written parser over the memory-mapped file
+};
+
 
 /**
  * \class BenchParser
@@ -64,6 +127,7 @@ class BenchParser {
 private:
 
     size_t id_counter;
+    bool verbose;   ///< Print the progress of parsing and sorting
 
     std::set<label_t> output_labels;     ///< Set containing bench node labels of all OUTPUT gates
     std::set<label_t> ff_labels;   ///< Set containing bench node labels of all FLIP FLOP gates.
@@ -80,7 +144,7 @@ private:
     std::unordered_map<size_t, circuit_node_t> id_to_circuit_node;  ///< Mapping from circuit unique IDs to circuit nodes
 
     /* Topological Sorted Circuit */
-    list_of_circuit_t sorted_circuit; ///< List contained the topological sorted circuit nodes
+    circuit_graph_t sorted_circuit; ///< Graph of the topological sorted circuit nodes
 
 
 
@@ -206,6 +270,25 @@ private:
      */
     bool parseFile(const std::string& bench_file);
 
+    /**
+     * \brief Reads the file containing the circuit in the bench format through a memory mapping.
+     * \param bench_file is std::string.
+     * \return bool returns true in case of success.
+     *
+     *  Accepts the same format as parseFile, but tokenises the mapped file in
+     *      place and only copies the labels into the label table.
+     */
+    bool parseMappedFile(const std::string& bench_file);
+
+    /**
+     * \brief Parses a single line of a bench file.
+     * \param line is std::string_view without the line break.
+     * \return bool returns false if the line is malformed.
+     *
+     *  Blank and comment lines are accepted and ignored.
+     */
+    bool parseLine(std::string_view line);
+
     /* ----------------
      * Insert functions
      * ----------------
@@ -295,26 +378,12 @@ private:
      * \param none
      * \return none (the result is stored at sorted_circuit variable)
      *
+     *  Works on arrays indexed by the circuit unique IDs. Nodes are sorted from the
+     *      outputs backwards, always taking the smallest unique ID among the nodes
+     *      without outgoing edges left.
      */
     void TopologicalSortKahnsAlgorithm();
 
-    /* -----------------------------
-     * Auxiliar functions for
-     * Topological Sort Algorithms
-     * -----------------------------
-     */
-
-    /**
-     * \brief auxiliar function for topological sort algorithms.
-     * \param src_node is unique_ID_t
-     * \param dst_node is unique_ID_t
-     * \return True if it was the only outgoing edge. False, otherwise.
-     *
-     * It removes the edge from src->dst at the table uuid2circuitNode and
-     * then checks if it was the only outgoing edge.
-     */
-    bool IsUniqueOutgoingEdge(unique_ID_t src_node, unique_ID_t dst_node);
-
 public:
     /**
     * \brief Constructor
@@ -323,8 +392,11 @@ public:
     * Constructor method for the bench_circuit_manager class. It
     * generates the topological circuit described in the file
     * bench_file that must be in the ISCAS85/ISCAS89/ISCAS99 format.
+    * If verbose is false, no progress is printed. The backend selects
+    * the parser used to read the file.
     */
-    explicit BenchParser(const std::string& bench_file);
+    explicit BenchParser(const std::string& bench_file, bool verbose = true,
+                         ParserBackend backend = ParserBackend::Spirit);
 
     ~BenchParser();
 
@@ -345,4 +417,29 @@ public:
      */
     std::set<label_t> GetListOfOutputLabels();
 
+    /**
+     * \brief return the topologically sorted circuit nodes in the transitive fan-in of the given outputs.
+     * \param output_labels is std::set<label_t> containing labels of GetListOfOutputLabels
+     * \return list_of_circuit_t
+     *
+     *  Building only these nodes is enough to get the BDDs of the given outputs.
+     */
+    list_of_circuit_t GetSortedCone(const std::set<label_t> &output_labels);
+
+    /**
+     * \brief return the topologically sorted circuit as a graph.
+     * \param none
+     * \return const circuit_graph_t &
+     *
+     */
+    const circuit_graph_t &GetCircuitGraph();
+
+    /**
+     * \brief return the graph of the circuit nodes in the transitive fan-in of the given outputs.
+     * \param output_labels is std::set<label_t> containing labels of GetListOfOutputLabels
+     * \return circuit_graph_t
+     *
+     */
+    circuit_graph_t GetConeGraph(const std::set<label_t> &output_labels);
+
 };
@@ -0,0 +1,142 @@
+#include "CircuitStrash.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+CircuitStrash::CircuitStrash(const circuit_graph_t &circuit) {
+    fanin_offsets.push_back(0);
+    /* Node 0 is the constant false */
+    AddNode(gate_type_t::Input, "");
+    circuit_literals.resize(circuit.size());
+
+    for (size_t node = 0; node < circuit.size(); node++) {
+        operands.clear();
+        for (size_t j = circuit.fanin_offsets[node]; j < circuit.fanin_offsets[node + 1]; j++)
+            operands.push_back(circuit_literals[circuit.fanin[j]]);
+        gate_type_t gate_type = circuit.gate_types[node];
+        if (gate_type != gate_type_t::Input && operands.empty())
+            throw std::runtime_error("The gate " + circuit.labels[node] + " has no inputs!");
+
+        literal_t literal;
+        switch (gate_type) {
+            case gate_type_t::Input:
+                literal = 2 * AddNode(gate_type_t::Input, circuit.labels[node]);
+                break;
+            case gate_type_t::Output:
+            case gate_type_t::FlipFlop:
+            case gate_type_t::Buffer:
+                literal = operands.front();
+                break;
+            case gate_type_t::Not:
+                literal = operands.front() ^ 1;
+                break;
+            case gate_type_t::And:
+                literal = HashAnd();
+                break;
+            case gate_type_t::Nand:
+                literal = HashAnd() ^ 1;
+                break;
+            case gate_type_t::Or:
+                /* De Morgan: a + b = !(!a & !b) */
+                for (auto &operand : operands)
+                    operand ^= 1;
+                literal = HashAnd() ^ 1;
+                break;
+            case gate_type_t::Nor:
+                for (auto &operand : operands)
+                    operand ^= 1;
+                literal = HashAnd();
+                break;
+            case gate_type_t::Xor:
+                literal = HashXor();
+                break;
+            default:
+                throw std::runtime_error(std::string("Unsupported gate type ") + GateTypeName(gate_type) + "!");
+        }
+        circuit_literals[node] = literal;
+    }
+
+    unique_nodes.clear();
+    operands.clear();
+}
+
+size_t CircuitStrash::KeyHash::operator()(const std::vector<literal_t> &key) const {
+    size_t hash = key.size();
+    for (literal_t literal : key)
+        hash = (hash ^ literal) * 0x100000001b3ULL;
+    return hash;
+}
+
+CircuitStrash::literal_t CircuitStrash::HashAnd() {
+    std::sort(operands.begin(), operands.end());
+    operands.erase(std::unique(operands.begin(), operands.end()), operands.end());
+
+    /* A false input makes the AND false, true inputs are dropped */
+    if (operands.front() == 0)
+        return 0;
+    if (operands.front() == 1)
+        operands.erase(operands.begin());
+    if (operands.empty())
+        return 1;
+
+    /* a & !a is false, both literals are adjacent after sorting */
+    for (size_t i = 1; i < operands.size(); i++) {
+        if ((operands[i] ^ operands[i - 1]) == 1)
+            return 0;
+    }
+    if (operands.size() == 1)
+        return operands.front();
+    return 2 * FindOrAddNode(gate_type_t::And);
+}
+
+CircuitStrash::literal_t CircuitStrash::HashXor() {
+    /* Complemented inputs and true inputs are moved to the output */
+    literal_t complement = 0;
+    for (auto &operand : operands) {
+        complement ^= operand & 1;
+        operand &= ~static_cast<literal_t>(1);
+    }
+    std::sort(operands.begin(), operands.end());
+
+    /* a ^ a is false, drop pairs of equal inputs and the constant */
+    size_t size = 0;
+    for (literal_t operand : operands) {
+        if (operand == 0)
+            continue;
+        if (size != 0 && operands[size - 1] == operand)
+            size--;
+        else
+            operands[size++] = operand;
+    }
+    operands.resize(size);
+
+    if (operands.empty())
+        return complement;
+    if (operands.size() == 1)
+        return operands.front() ^ complement;
+    return (2 * FindOrAddNode(gate_type_t::Xor)) ^ complement;
+}
+
+size_t CircuitStrash::FindOrAddNode(gate_type_t gate_type) {
+    std::vector<literal_t> key;
+    key.reserve(operands.size() + 1);
+    key.push_back(static_cast<literal_t>(gate_type));
+    key.insert(key.end(), operands.begin(), operands.end());
+
+    auto search = unique_nodes.find(key);
+    if (search != unique_nodes.end())
+        return search->second;
+
+    fanin.insert(fanin.end(), operands.begin(), operands.end());
+    size_t node = AddNode(gate_type, "");
+    unique_nodes.emplace(std::move(key), node);
+    return node;
+}
+
+size_t CircuitStrash::AddNode(gate_type_t gate_type, const label_t &label) {
+    gate_types.push_back(gate_type);
+    labels.push_back(label);
+    fanin_offsets.push_back(fanin.size());
+    return gate_types.size() - 1;
+}
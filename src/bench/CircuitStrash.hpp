@@ -0,0 +1,115 @@
+#pragma once
+
+#include "BenchParser.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * \class CircuitStrash
+ *
+ * \brief Structural hashing and constant propagation of a circuit graph
+ *
+ *  Rewrites a topologically sorted circuit into a graph of INPUT, AND and XOR nodes whose edges may be
+ *  complemented, like an and-inverter graph. OR, NAND and NOR gates become AND nodes with complemented edges,
+ *  BUFF and NOT gates become plain or complemented edges, and constants are propagated. Gates with the same
+ *  type and the same inputs are merged into one node.
+ *
+ *  An edge is a literal 2 * node + complement. Node 0 is the constant false, so literal 0 is false and
+ *  literal 1 is true.
+ *
+ */
+class CircuitStrash {
+
+public:
+
+    typedef size_t literal_t; ///< Type definition for a possibly complemented node
+
+    /**
+     * \brief Constructor
+     * \param circuit is the topologically sorted circuit graph to be hashed
+     */
+    explicit CircuitStrash(const circuit_graph_t &circuit);
+
+    /**
+     * \brief returns the number of nodes of the hashed graph, including the constant node 0
+     * \param none
+     * \return size_t
+     */
+    size_t Size() const { return gate_types.size(); }
+
+    /**
+     * \brief returns the gate type of a node, which is INPUT, AND or XOR
+     * \param node is the index of the node, greater than 0
+     * \return gate_type_t
+     */
+    gate_type_t GetGateType(size_t node) const { return gate_types[node]; }
+
+    /**
+     * \brief returns the label of an INPUT node
+     * \param node is the index of the node
+     * \return const label_t &
+     */
+    const label_t &GetLabel(size_t node) const { return labels[node]; }
+
+    /**
+     * \brief returns the input literals of a node, they are sorted and refer to nodes with smaller indices
+     * \param node is the index of the node
+     * \return pair of pointers to the first and behind the last literal
+     */
+    std::pair<const literal_t *, const literal_t *> GetFanIn(size_t node) const {
+        return {fanin.data() + fanin_offsets[node], fanin.data() + fanin_offsets[node + 1]};
+    }
+
+    /**
+     * \brief returns the literal a node of the original circuit graph is equivalent to
+     * \param position is the position of the node in the original circuit graph
+     * \return literal_t
+     */
+    literal_t GetLiteral(size_t position) const { return circuit_literals[position]; }
+
+private:
+
+    struct KeyHash {
+        size_t operator()(const std::vector<literal_t> &key) const;
+    };
+
+    std::vector<gate_type_t> gate_types;     ///< Gate type of each node
+    std::vector<label_t> labels;             ///< Label of each INPUT node, empty for the other nodes
+    std::vector<size_t> fanin_offsets;       ///< Start of the fan-in of each node, with one extra entry at the end
+    std::vector<literal_t> fanin;            ///< Input literals of the nodes
+    std::vector<literal_t> circuit_literals; ///< Literal of each node of the original circuit graph
+
+    std::unordered_map<std::vector<literal_t>, size_t, KeyHash> unique_nodes; ///< Gate type and inputs -> node
+    std::vector<literal_t> operands; ///< Scratch buffer for the inputs of the gate being hashed
+
+    /**
+     * \brief Returns the literal of an AND of the literals in operands, creating a node if necessary
+     * \param none
+     * \return literal_t
+     */
+    literal_t HashAnd();
+
+    /**
+     * \brief Returns the literal of an XOR of the literals in operands, creating a node if necessary
+     * \param none
+     * \return literal_t
+     */
+    literal_t HashXor();
+
+    /**
+     * \brief Returns the node of the given gate type with the inputs in operands, creating it if necessary
+     * \param gate_type is gate_type_t
+     * \return size_t
+     */
+    size_t FindOrAddNode(gate_type_t gate_type);
+
+    /**
+     * \brief Appends a node to the graph
+     * \param gate_type is gate_type_t
+     * \param label is label_t
+     * \return size_t
+     */
+    size_t AddNode(gate_type_t gate_type, const label_t &label);
+};
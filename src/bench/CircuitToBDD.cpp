@@ -5,18 +5,27 @@
 
 #include "CircuitToBDD.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 
-CircuitToBDD::CircuitToBDD(shared_ptr<ClassProject::ManagerInterface> BDD_manager_p) {
+CircuitToBDD::CircuitToBDD(shared_ptr<ClassProject::ManagerInterface> BDD_manager_p, bool background_writer) {
     bdd_manager = std::move(BDD_manager_p);
+    writer = std::make_unique<ResultWriter>(background_writer);
 }
 
 CircuitToBDD::~CircuitToBDD() = default;
 
 void CircuitToBDD::GenerateBDD(const list_of_circuit_t &circuit, const std::string& benchmark_file) {
-    ClassProject::BDD_ID BDD_node;
+    GenerateBDD(ToCircuitGraph(circuit), benchmark_file);
+}
+
+void CircuitToBDD::GenerateBDD(const list_of_circuit_t &circuit) {
+    GenerateBDD(ToCircuitGraph(circuit));
+}
 
+void CircuitToBDD::GenerateBDD(const circuit_graph_t &circuit, const std::string& benchmark_file) {
     std::filesystem::path pathToBenchFile(benchmark_file);
     if (!pathToBenchFile.has_filename())
         throw std::runtime_error("circuit_to_BDD_manager::GenerateBDD: benchmark_file not specified");
@@ -28,269 +37,380 @@ void CircuitToBDD::GenerateBDD(const list_of_circuit_t &circuit, const std::stri
         throw std::runtime_error("Unable to create directory 'result' for the output!");
     }
 
-    std::ofstream bdd_out_file(result_dir + "/BNode_BDD.csv");
+    /* The CSV is written while the BDD is generated, in the background if enabled */
+    writer->Open(result_dir + "/BNode_BDD.csv");
+    *writer << "BDD_ID,Bench Label\n";
+    GenerateNodes(circuit, true);
+    writer->Close();
+    /* Report a CSV that could not be written here, not only in PrintBDD */
+    writer->Finish();
+}
+
+void CircuitToBDD::GenerateBDD(const circuit_graph_t &circuit) {
+    GenerateNodes(circuit, false);
+}
 
-    if (!bdd_out_file.is_open()) {
-        throw std::runtime_error("Unable to open Log File!");
+void CircuitToBDD::GenerateNodes(const circuit_graph_t &circuit, bool write_csv) {
+    std::unique_ptr<CircuitStrash> strash;
+    if (structural_hashing) {
+        strash = std::make_unique<CircuitStrash>(circuit);
+        GenerateStrashNodes(circuit, *strash);
+    } else {
+        node_bdd_ids.assign(circuit.size(), 0);
     }
+    label_to_bdd_id.reserve(label_to_bdd_id.size() + circuit.size());
 
-    bdd_out_file << "BDD_ID,Bench Label" << std::endl;
-
-    for (const auto &circuit_node : circuit) {
-        if (circuit_node.gate_type == INPUT_GATE_T) {
-            BDD_node = InputGate(circuit_node.label);
-        } else if (circuit_node.gate_type == NOT_GATE_T) {
-            BDD_node = NotGate(circuit_node.input_id_list);
-        } else if (circuit_node.gate_type == AND_GATE_T) {
-            BDD_node = AndGate(circuit_node.input_id_list);
-        } else if (circuit_node.gate_type == OR_GATE_T) {
-            BDD_node = OrGate(circuit_node.input_id_list);
-        } else if (circuit_node.gate_type == NAND_GATE_T) {
-            BDD_node = NandGate(circuit_node.input_id_list);
-        } else if (circuit_node.gate_type == NOR_GATE_T) {
-            BDD_node = NorGate(circuit_node.input_id_list);
-        } else if (circuit_node.gate_type == XOR_GATE_T) {
-            BDD_node = XorGate(circuit_node.input_id_list);
-        } else if (circuit_node.gate_type == BUFFER_GATE_T) {
-            BDD_node = findBddId(*circuit_node.input_id_list.begin());
+    for (size_t node = 0; node < circuit.size(); node++) {
+        /* OUTPUT or FLIP FLOP gates do not generate a BDD */
+        gate_type_t gate_type = circuit.gate_types[node];
+        if (gate_type == gate_type_t::Output || gate_type == gate_type_t::FlipFlop)
+            continue;
+        ClassProject::BDD_ID BDD_node;
+        if (strash) {
+            BDD_node = node_bdd_ids[strash->GetLiteral(node)];
+        } else {
+            BDD_node = GenerateNode(circuit, node);
+            node_bdd_ids[node] = BDD_node;
         }
+        label_to_bdd_id.insert(std::pair<label_t, ClassProject::BDD_ID>(circuit.labels[node], BDD_node));
+        if (write_csv)
+            *writer << BDD_node << ',' << circuit.labels[node] << '\n';
+    }
+}
 
-        /* OUTPUT or FLIP FLOP gates do not generate a BDD */
-        if (!((circuit_node.gate_type == OUTPUT_GATE_T) | (circuit_node.gate_type == FLIP_FLOP_GATE_T))) {
-            node_to_bdd_id.insert(std::pair<unique_ID_t, ClassProject::BDD_ID>(circuit_node.id, BDD_node));
-            label_to_bdd_id.insert(std::pair<label_t, ClassProject::BDD_ID>(circuit_node.label, BDD_node));
-            bdd_out_file << BDD_node << "," << circuit_node.label << std::endl;
+/* An AND whose inputs are all complemented stems from an OR or NOR gate and is built as one */
+static bool IsInvertedAnd(const CircuitStrash &strash, size_t node) {
+    if (strash.GetGateType(node) != gate_type_t::And)
+        return false;
+    auto fanin = strash.GetFanIn(node);
+    return std::all_of(fanin.first, fanin.second, [](CircuitStrash::literal_t literal) { return literal & 1; });
+}
+
+void CircuitToBDD::GenerateStrashNodes(const circuit_graph_t &circuit, const CircuitStrash &strash) {
+    /* Mark the literals that are used, from the gates of the circuit down to the inputs */
+    std::vector<bool> used(2 * strash.Size(), false);
+    for (size_t node = 0; node < circuit.size(); node++) {
+        if (circuit.gate_types[node] != gate_type_t::Output && circuit.gate_types[node] != gate_type_t::FlipFlop)
+            used[strash.GetLiteral(node)] = true;
+    }
+    for (size_t node = strash.Size(); node-- > 1;) {
+        if (strash.GetGateType(node) == gate_type_t::Input || (!used[2 * node] && !used[2 * node + 1]))
+            continue;
+        CircuitStrash::literal_t flip = IsInvertedAnd(strash, node) ? 1 : 0;
+        auto fanin = strash.GetFanIn(node);
+        for (auto it = fanin.first; it != fanin.second; ++it)
+            used[*it ^ flip] = true;
+    }
+
+    node_bdd_ids.assign(2 * strash.Size(), bdd_manager->False());
+    node_bdd_ids[1] = bdd_manager->True();
+    for (size_t node = 1; node < strash.Size(); node++) {
+        if (strash.GetGateType(node) == gate_type_t::Input) {
+            /* Variables are always created, to keep the variable order */
+            node_bdd_ids[2 * node] = InputGate(strash.GetLabel(node));
+            if (used[2 * node + 1])
+                node_bdd_ids[2 * node + 1] = bdd_manager->neg(node_bdd_ids[2 * node]);
+            continue;
+        }
+        if (used[2 * node]) {
+            node_bdd_ids[2 * node] = GenerateStrashLiteral(strash, 2 * node);
+            /* Negating shares more nodes than building the complement from the inputs again */
+            if (used[2 * node + 1])
+                node_bdd_ids[2 * node + 1] = bdd_manager->neg(node_bdd_ids[2 * node]);
+        } else if (used[2 * node + 1]) {
+            node_bdd_ids[2 * node + 1] = GenerateStrashLiteral(strash, 2 * node + 1);
         }
     }
+}
 
-    bdd_out_file.close();
+ClassProject::BDD_ID CircuitToBDD::GenerateStrashLiteral(const CircuitStrash &strash, CircuitStrash::literal_t literal) {
+    size_t node = literal >> 1;
+    bool complemented = literal & 1;
+    auto fanin = strash.GetFanIn(node);
+    const CircuitStrash::literal_t *first = fanin.first;
+
+    /* Operands of an inverted AND are used in positive polarity, the gate is then an OR or a NOR */
+    CircuitStrash::literal_t flip = IsInvertedAnd(strash, node) ? 1 : 0;
+    auto fold = [&](const CircuitStrash::literal_t *it, ClassProject::BDD_ID (ClassProject::ManagerInterface::*op)(
+            ClassProject::BDD_ID, ClassProject::BDD_ID)) {
+        ClassProject::BDD_ID result = node_bdd_ids[*it ^ flip];
+        for (++it; it != fanin.second; ++it)
+            result = (bdd_manager.get()->*op)(result, node_bdd_ids[*it ^ flip]);
+        return result;
+    };
+
+    if (strash.GetGateType(node) == gate_type_t::Xor) {
+        if (!complemented)
+            return fold(first, &ClassProject::ManagerInterface::xor2);
+        return bdd_manager->xnor2(node_bdd_ids[*first], fold(first + 1, &ClassProject::ManagerInterface::xor2));
+    }
+    if (flip) {
+        if (complemented)
+            return fold(first, &ClassProject::ManagerInterface::or2);
+        return bdd_manager->nor2(node_bdd_ids[*first ^ flip], fold(first + 1, &ClassProject::ManagerInterface::or2));
+    }
+    if (!complemented)
+        return fold(first, &ClassProject::ManagerInterface::and2);
+    return bdd_manager->nand2(node_bdd_ids[*first], fold(first + 1, &ClassProject::ManagerInterface::and2));
 }
 
+void CircuitToBDD::BindInput(const label_t &label, ClassProject::BDD_ID var) {
+    bound_inputs[label] = var;
+}
 
-ClassProject::BDD_ID CircuitToBDD::findBddId(unique_ID_t circuit_node) {
+ClassProject::BDD_ID CircuitToBDD::GetBddId(const label_t &label) {
 
-    auto bdd_id_it = node_to_bdd_id.find(circuit_node);
+    auto bdd_id_it = label_to_bdd_id.find(label);
 
-    if (bdd_id_it != node_to_bdd_id.end()) {
+    if (bdd_id_it != label_to_bdd_id.end()) {
         return bdd_id_it->second;
     } else {
-        throw std::runtime_error("Destination node ID is not part of the circuit graph!");
+        throw std::runtime_error("There is no BDD for the label " + label + "!");
+    }
+}
+
+ClassProject::BDD_ID CircuitToBDD::GenerateNode(const circuit_graph_t &circuit, size_t node) {
+    const size_t *first = circuit.fanin.data() + circuit.fanin_offsets[node];
+    const size_t *last = circuit.fanin.data() + circuit.fanin_offsets[node + 1];
+    if (circuit.gate_types[node] != gate_type_t::Input && first == last)
+        throw std::runtime_error("The gate " + circuit.labels[node] + " has no inputs!");
+
+    switch (circuit.gate_types[node]) {
+        case gate_type_t::Input:
+            return InputGate(circuit.labels[node]);
+        case gate_type_t::Not:
+            return NotGate(first);
+        case gate_type_t::And:
+            return AndGate(first, last);
+        case gate_type_t::Or:
+            return OrGate(first, last);
+        case gate_type_t::Nand:
+            return NandGate(first, last);
+        case gate_type_t::Nor:
+            return NorGate(first, last);
+        case gate_type_t::Xor:
+            return XorGate(first, last);
+        case gate_type_t::Buffer:
+            return node_bdd_ids[*first];
+        default:
+            break;
     }
+    throw std::runtime_error(std::string("Unsupported gate type ") + GateTypeName(circuit.gate_types[node]) + "!");
 }
 
 
 ClassProject::BDD_ID CircuitToBDD::InputGate(const label_t &label) {
+    auto bound_it = bound_inputs.find(label);
+    if (bound_it != bound_inputs.end())
+        return bound_it->second;
     return bdd_manager->createVar(label);
 }
 
 
-ClassProject::BDD_ID CircuitToBDD::NotGate(const set_of_circuit_t &inputNodes) {
-    unique_ID_t node = *inputNodes.begin();
-    return bdd_manager->neg(findBddId(node));
+ClassProject::BDD_ID CircuitToBDD::NotGate(const size_t *first) {
+    return bdd_manager->neg(node_bdd_ids[*first]);
 }
 
 
-ClassProject::BDD_ID CircuitToBDD::AndGate(set_of_circuit_t inputNodes) {
-    auto it = inputNodes.begin();
-    ClassProject::BDD_ID first_op, second_op;
-
+ClassProject::BDD_ID CircuitToBDD::AndGate(const size_t *first, const size_t *last) {
     /* Get the ClassProject::BDD_ID of first elements */
-    first_op = findBddId(*it);
-    inputNodes.erase(it);
+    ClassProject::BDD_ID result = node_bdd_ids[*first];
 
-    while (!inputNodes.empty()) {
-        it = inputNodes.begin();
-        second_op = findBddId(*it);
-        inputNodes.erase(it);
-
-        first_op = bdd_manager->and2(first_op, second_op);
-    }
+    for (++first; first != last; ++first)
+        result = bdd_manager->and2(result, node_bdd_ids[*first]);
 
     /* Return the ClassProject::BDD_ID equivalent to the AND of all inputs */
-    return first_op;
+    return result;
 }
 
 
-ClassProject::BDD_ID CircuitToBDD::OrGate(set_of_circuit_t inputNodes) {
-    auto it = inputNodes.begin();
-    ClassProject::BDD_ID first_op, second_op;
-
+ClassProject::BDD_ID CircuitToBDD::OrGate(const size_t *first, const size_t *last) {
     /* Get the ClassProject::BDD_ID of first elements */
-    first_op = findBddId(*it);
-    inputNodes.erase(it);
-
-    while (!inputNodes.empty()) {
-        it = inputNodes.begin();
-        second_op = findBddId(*it);
-        inputNodes.erase(it);
+    ClassProject::BDD_ID result = node_bdd_ids[*first];
 
-        first_op = bdd_manager->or2(first_op, second_op);
-    }
+    for (++first; first != last; ++first)
+        result = bdd_manager->or2(result, node_bdd_ids[*first]);
 
     /* Return the ClassProject::BDD_ID equivalent to the OR of all inputs */
-    return first_op;
+    return result;
 }
 
-ClassProject::BDD_ID CircuitToBDD::NandGate(set_of_circuit_t inputNodes) {
-    auto it = inputNodes.begin();
-    ClassProject::BDD_ID first_op, second_op;
-
+ClassProject::BDD_ID CircuitToBDD::NandGate(const size_t *first, const size_t *last) {
     /* Get the ClassProject::BDD_ID of first elements */
-    it = inputNodes.begin();
-    first_op = findBddId(*it);
-    inputNodes.erase(it);
+    ClassProject::BDD_ID first_op = node_bdd_ids[*first];
 
-    if (inputNodes.size() == 1) {
-        it = inputNodes.begin();
-        second_op = findBddId(*it);
-        inputNodes.erase(it);
+    /* Inputs that are listed twice are merged, which can leave a single one */
+    if (last - first == 1)
+        return bdd_manager->neg(first_op);
 
-        /* Create the NAND BDD node for the first two elements */
-        first_op = bdd_manager->nand2(first_op, second_op);
-    } else {
-        /* AND of all inputs, to use as the second operator of the NAND gate */
-        second_op = AndGate(inputNodes);
-        /* Create the NAND BDD node */
-        first_op = bdd_manager->nand2(first_op, second_op);
-    }
+    /* AND of all other inputs, to use as the second operator of the NAND gate */
+    ClassProject::BDD_ID second_op = last - first == 2 ? node_bdd_ids[first[1]] : AndGate(first + 1, last);
 
     /* Return the ClassProject::BDD_ID equivalent to the NAND of all inputs */
-    return first_op;
+    return bdd_manager->nand2(first_op, second_op);
 }
 
-ClassProject::BDD_ID CircuitToBDD::NorGate(set_of_circuit_t inputNodes) {
-    auto it = inputNodes.begin();
-    ClassProject::BDD_ID first_op, second_op;
-
+ClassProject::BDD_ID CircuitToBDD::NorGate(const size_t *first, const size_t *last) {
     /* Get the ClassProject::BDD_ID of first elements */
-    it = inputNodes.begin();
-    first_op = findBddId(*it);
-    inputNodes.erase(it);
+    ClassProject::BDD_ID first_op = node_bdd_ids[*first];
 
-    if (inputNodes.size() == 1) {
-        it = inputNodes.begin();
-        second_op = findBddId(*it);
-        inputNodes.erase(it);
+    /* Inputs that are listed twice are merged, which can leave a single one */
+    if (last - first == 1)
+        return bdd_manager->neg(first_op);
 
-        /* Create the NOR BDD node for the first two elements */
-        first_op = bdd_manager->nor2(first_op, second_op);
-    } else {
-        /* OR of all inputs, to use as the second operator of the NAND gate */
-        second_op = OrGate(inputNodes);
-        /* Create the NOR BDD node */
-        first_op = bdd_manager->nor2(first_op, second_op);
-    }
+    /* OR of all other inputs, to use as the second operator of the NOR gate */
+    ClassProject::BDD_ID second_op = last - first == 2 ? node_bdd_ids[first[1]] : OrGate(first + 1, last);
 
     /* Return the ClassProject::BDD_ID equivalent to the NOR of all inputs */
-    return first_op;
+    return bdd_manager->nor2(first_op, second_op);
 }
 
-ClassProject::BDD_ID CircuitToBDD::XorGate(set_of_circuit_t inputNodes) {
-    auto it = inputNodes.begin();
-    ClassProject::BDD_ID first_op, second_op;
-
+ClassProject::BDD_ID CircuitToBDD::XorGate(const size_t *first, const size_t *last) {
     /* Get the ClassProject::BDD_ID of first elements */
-    first_op = findBddId(*it);
-    inputNodes.erase(it);
+    ClassProject::BDD_ID result = node_bdd_ids[*first];
 
-    while (!inputNodes.empty()) {
-        it = inputNodes.begin();
-        second_op = findBddId(*it);
-        inputNodes.erase(it);
-
-        first_op = bdd_manager->xor2(first_op, second_op);
-    }
+    for (++first; first != last; ++first)
+        result = bdd_manager->xor2(result, node_bdd_ids[*first]);
 
     /* Return the ClassProject::BDD_ID equivalent to the XOR of all inputs */
-    return first_op;
+    return result;
 }
 
 void CircuitToBDD::PrintBDD(const std::set<label_t> &output_labels) {
 
-    if ((!(std::filesystem::exists(result_dir + "/txt")) &
-         !(std::filesystem::create_directory(result_dir + "/txt")))
-        & (!(std::filesystem::exists(result_dir + "/dot")) &
-           !(std::filesystem::create_directory(result_dir + "/dot")))) {
-        throw std::runtime_error("Unable to create directories 'txt' and 'dot' for the output!");
-    }
-
+    std::vector<std::pair<label_t, ClassProject::BDD_ID>> outputs;
     for (const auto &output_label : output_labels) {
-
         auto output_id_it = label_to_bdd_id.find(output_label);
+        if (output_id_it == label_to_bdd_id.end())
+            throw std::runtime_error("Destination node UUID is not part of the circuit graph!");
+        outputs.emplace_back(output_label, output_id_it->second);
+    }
 
-        if (output_id_it != label_to_bdd_id.end()) {
-
-            std::string dot_file_name = result_dir + "/dot/" + std::string(output_label) + ".dot";
-            std::string txt_file_name = result_dir + "/txt/" + std::string(output_label) + ".txt";
-
-            std::ofstream bdd_out_dot_file(dot_file_name);
-            std::ofstream bdd_out_txt_file(txt_file_name);
+    if (combined_output) {
+        /* Traverse the whole output forest once, shared nodes are written only once */
+        std::vector<ClassProject::BDD_ID> nodes;
+        visit_stamp++;
+        for (const auto &output : outputs)
+            CollectNodes(output.second, nodes);
+
+        writer->Open(result_dir + "/BDD.txt");
+        for (const auto &output : outputs)
+            *writer << "Output: " << output.first << " Root: " << output.second << '\n';
+        dumpBddText(*writer, nodes);
+        writer->Close();
+
+        writer->Open(result_dir + "/BDD.dot");
+        dumpBddDot(*writer, nodes, outputs);
+        writer->Close();
+    } else {
+        if ((!(std::filesystem::exists(result_dir + "/txt")) &
+             !(std::filesystem::create_directory(result_dir + "/txt")))
+            & (!(std::filesystem::exists(result_dir + "/dot")) &
+               !(std::filesystem::create_directory(result_dir + "/dot")))) {
+            throw std::runtime_error("Unable to create directories 'txt' and 'dot' for the output!");
+        }
 
-            if (!bdd_out_dot_file.is_open() | !bdd_out_txt_file.is_open()) {
-                throw std::runtime_error("Unable to open Log File!");
-            }
+        std::vector<ClassProject::BDD_ID> nodes;
+        for (const auto &output : outputs) {
+            nodes.clear();
+            visit_stamp++;
+            CollectNodes(output.second, nodes);
+
+            writer->Open(result_dir + "/txt/" + output.first + ".txt");
+            dumpBddText(*writer, nodes);
+            writer->Open(result_dir + "/dot/" + output.first + ".dot");
+            dumpBddDot(*writer, nodes, {});
+            writer->Close();
+        }
+    }
 
-            output_nodes.clear();
-            output_vars.clear();
-            bdd_manager->findNodes(output_id_it->second, output_nodes);
-            bdd_manager->findVars(output_id_it->second, output_vars);
+    writer->Finish();
+}
 
-            dumpBddText(bdd_out_txt_file);
-            dumpBddDot(bdd_out_dot_file);
+void CircuitToBDD::SetCombinedOutput(bool combined) {
+    combined_output = combined;
+}
 
-            bdd_out_dot_file.close();
-            bdd_out_txt_file.close();
+void CircuitToBDD::SetStructuralHashing(bool enabled) {
+    structural_hashing = enabled;
+}
 
-        } else {
-            throw std::runtime_error("Destination node UUID is not part of the circuit graph!");
+void CircuitToBDD::CollectNodes(ClassProject::BDD_ID root, std::vector<ClassProject::BDD_ID> &nodes) {
+    if (visited.size() < bdd_manager->uniqueTableSize())
+        visited.resize(bdd_manager->uniqueTableSize(), 0);
+
+    std::vector<ClassProject::BDD_ID> stack = {root};
+    while (!stack.empty()) {
+        ClassProject::BDD_ID node = stack.back();
+        stack.pop_back();
+        if (visited[node] == visit_stamp)
+            continue;
+        visited[node] = visit_stamp;
+        nodes.push_back(node);
+        if (!bdd_manager->isConstant(node)) {
+            stack.push_back(bdd_manager->coFactorTrue(node));
+            stack.push_back(bdd_manager->coFactorFalse(node));
         }
     }
 }
 
-void CircuitToBDD::dumpBddText(std::ostream &out) {
-    for (auto it = output_nodes.rbegin(); it != output_nodes.rend(); ++it) {
-        if (bdd_manager->isConstant(*it)) {
-            out << "Terminal Node: " << (*it) << "\n";
+void CircuitToBDD::dumpBddText(ResultWriter &out, std::vector<ClassProject::BDD_ID> &nodes) {
+    std::sort(nodes.begin(), nodes.end(), std::greater<>());
+    for (const auto node : nodes) {
+        if (bdd_manager->isConstant(node)) {
+            out << "Terminal Node: " << node << '\n';
         } else {
-            out << "Variable Node: " << (*it)
-                << " Top Var Id: " << bdd_manager->topVar(*it)
-                << " Top Var Name: " << bdd_manager->getTopVarName(bdd_manager->topVar(*it))
-                << " Low: " << bdd_manager->coFactorFalse(*it)
-                << " High: " << bdd_manager->coFactorTrue(*it) << "\n";
+            ClassProject::BDD_ID top_var = bdd_manager->topVar(node);
+            out << "Variable Node: " << node
+                << " Top Var Id: " << top_var
+                << " Top Var Name: " << bdd_manager->getTopVarName(top_var)
+                << " Low: " << bdd_manager->coFactorFalse(node)
+                << " High: " << bdd_manager->coFactorTrue(node) << '\n';
         }
     }
 }
 
-void CircuitToBDD::dumpBddDot(std::ostream &out) {
+void CircuitToBDD::dumpBddDot(ResultWriter &out, std::vector<ClassProject::BDD_ID> &nodes,
+                              const std::vector<std::pair<label_t, ClassProject::BDD_ID>> &roots) {
+    /* Group the nodes by their variable, the variables are in order */
+    std::vector<std::pair<ClassProject::BDD_ID, ClassProject::BDD_ID>> var_nodes;
+    for (const auto node : nodes) {
+        if (!bdd_manager->isConstant(node))
+            var_nodes.emplace_back(bdd_manager->topVar(node), node);
+    }
+    std::sort(var_nodes.begin(), var_nodes.end());
+    std::sort(nodes.begin(), nodes.end());
+
     out << "digraph BDD {\n";
     out << "center = true;\n";
     out << "{ rank = same; { node [style=invis]; \"T\" };\n";
     out << " { node [shape=box,fontsize=12]; \"0\"; }\n";
     out << "  { node [shape=box,fontsize=12]; \"1\"; }\n}\n";
-    for (const auto var : output_vars) {
+    for (auto it = var_nodes.begin(); it != var_nodes.end();) {
+        ClassProject::BDD_ID var = it->first;
         out << R"({ rank=same; { node [shape=plaintext,fontname="Times Italic",fontsize=12] ")"
             << bdd_manager->getTopVarName(var) << "\" };";
-        for (unsigned long node : output_nodes) {
-            if (bdd_manager->topVar(node) == var) {
-                out << "\"" << node << "\";";
-            }
-        }
+        for (; it != var_nodes.end() && it->first == var; ++it)
+            out << '"' << it->second << "\";";
         out << "}\n";
     }
     out << "edge [style = invis]; {";
-    for (const auto var : output_vars) {
-        out << "\"" << bdd_manager->getTopVarName(var) << "\" -> ";
+    for (auto it = var_nodes.begin(); it != var_nodes.end(); ++it) {
+        if (it == var_nodes.begin() || std::prev(it)->first != it->first)
+            out << '"' << bdd_manager->getTopVarName(it->first) << "\" -> ";
     }
     out << "\"T\"; }\n";
-    for (const auto node : output_nodes) {
+    for (const auto node : nodes) {
         if (!bdd_manager->isConstant(node)) {
-            out << "\"" << node << "\" -> \"" << bdd_manager->coFactorTrue(node)
+            out << '"' << node << "\" -> \"" << bdd_manager->coFactorTrue(node)
                 << "\" [style=solid,arrowsize=\".75\"];\n";
-            out << "\"" << node << "\" -> \"" << bdd_manager->coFactorFalse(node)
+            out << '"' << node << "\" -> \"" << bdd_manager->coFactorFalse(node)
                 << "\" [style=dashed,arrowsize=\".75\"];\n";
         }
     }
+    for (const auto &root : roots) {
+        out << "{ node [shape=plaintext,fontsize=12]; \"" << root.first << "\"; }\n";
+        out << "\"" << root.first << "\" -> \"" << root.second << "\" [style=solid,arrowsize=\".75\"];\n";
+    }
     out << "}\n";
 }
-
-
@@ -6,7 +6,9 @@
 #pragma once
 
 #include "BenchParser.hpp"
+#include "CircuitStrash.hpp"
 #include "../ManagerInterface.h"
+#include "ResultWriter.hpp"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -26,7 +28,12 @@ class CircuitToBDD {
 
 public:
 
-    explicit CircuitToBDD(shared_ptr<ClassProject::ManagerInterface> BDD_manager_p);
+    /**
+     * \brief Constructor
+     * \param BDD_manager_p is the BDD manager the BDDs are generated in
+     * \param background_writer true, to write the result files on a background thread while the BDD is generated
+     */
+    explicit CircuitToBDD(shared_ptr<ClassProject::ManagerInterface> BDD_manager_p, bool background_writer = false);
     ~CircuitToBDD();
 
     /**
@@ -36,36 +43,130 @@ public:
      *
      *  Generates the calls to the BDD package in order to
      *   generate the BDD equivalent to the provided circuit.
+     *  Throws std::runtime_error if BNode_BDD.csv cannot be written.
      */
     void GenerateBDD(const std::list<circuit_node_t> &circuit, const std::string& benchmark_file);
 
+    /**
+     * \brief Generates a BDD from the circuit nodes provided without writing any result files
+     * \param Topologically sorted list containing the circuit nodes
+     * \return none
+     */
+    void GenerateBDD(const std::list<circuit_node_t> &circuit);
+
+    /**
+     * \brief Generates a BDD from the circuit graph provided
+     * \param Topologically sorted circuit graph
+     * \return none
+     *
+     *  Same as the list version, without converting the circuit first.
+     */
+    void GenerateBDD(const circuit_graph_t &circuit, const std::string& benchmark_file);
+
+    /**
+     * \brief Generates a BDD from the circuit graph provided without writing any result files
+     * \param Topologically sorted circuit graph
+     * \return none
+     */
+    void GenerateBDD(const circuit_graph_t &circuit);
+
+    /**
+     * \brief Binds an INPUT gate to an existing variable instead of creating a new one
+     * \param label is label_t of the INPUT gate
+     * \param var is the ClassProject::BDD_ID of the variable
+     * \return none
+     *
+     *  Has to be called before GenerateBDD.
+     */
+    void BindInput(const label_t &label, ClassProject::BDD_ID var);
+
+    /**
+     * \brief Returns the BDD_ID of the gate with the given label
+     * \param label is label_t
+     * \return ClassProject::BDD_ID
+     *
+     */
+    ClassProject::BDD_ID GetBddId(const label_t &label);
+
 
     /**
      * \brief Print the generated BDD in text and dot format
      * \param The set of output labels to print a BDD for
      * \return none
+     *
+     *  Writes one txt and one dot file per output, or a single combined BDD.txt and BDD.dot if enabled by
+     *  SetCombinedOutput. The nodes of the combined files are written only once, even if shared by several outputs.
      */
     void PrintBDD(const std::set<label_t> &output_labels);
 
+    /**
+     * \brief Selects whether PrintBDD writes one combined file for all outputs
+     * \param combined true, to write a single txt and dot file
+     * \return none
+     */
+    void SetCombinedOutput(bool combined);
+
+    /**
+     * \brief Selects whether GenerateBDD hashes the circuit structurally before generating the BDD
+     * \param enabled true, to generate the BDD from the CircuitStrash graph of the circuit
+     * \return none
+     *
+     *  Duplicate gates, buffers, double inversions and constants are removed before any BDD operation,
+     *  every gate still gets its BDD.
+     */
+    void SetStructuralHashing(bool enabled);
+
 private:
 
-    std::unordered_map<unique_ID_t, ClassProject::BDD_ID> node_to_bdd_id; ///< Mapping from circuit node's unique ID to its BDD ID
+    std::vector<ClassProject::BDD_ID> node_bdd_ids; ///< BDD ID of each node, or each CircuitStrash literal, being generated
     std::unordered_map<label_t, ClassProject::BDD_ID> label_to_bdd_id; ///< Mapping from node's label to its BDD ID
+    std::unordered_map<label_t, ClassProject::BDD_ID> bound_inputs; ///< Mapping from INPUT labels to existing variables
 
     shared_ptr<ClassProject::ManagerInterface> bdd_manager{};
     std::string result_dir; ///< Directory where the results are stored
 
-    std::set<ClassProject::BDD_ID> output_nodes;
-    std::set<ClassProject::BDD_ID> output_vars;
+    std::unique_ptr<ResultWriter> writer;
+    bool combined_output = false;
+    bool structural_hashing = false;
+    std::vector<size_t> visited;    ///< Stamp of the last traversal that visited a node
+    size_t visit_stamp = 0;
+
+
+    /**
+     * \brief Generates the BDD nodes of all gates of the circuit graph
+     * \param circuit is circuit_graph_t
+     * \param write_csv true, to write the BDD ID of each gate to the open writer
+     * \return none
+     */
+    void GenerateNodes(const circuit_graph_t &circuit, bool write_csv);
+
+    /**
+     * \brief Generates the BDDs of the literals of the structurally hashed circuit graph that are used
+     * \param circuit is circuit_graph_t the graph was hashed from
+     * \param strash is CircuitStrash
+     * \return none (the BDD of each used literal is stored at node_bdd_ids)
+     *
+     *  The manager has no complement edges, so a node only used complemented is built directly in that
+     *  polarity, e.g. a complemented AND with nand2. A node used in both polarities is negated.
+     */
+    void GenerateStrashNodes(const circuit_graph_t &circuit, const CircuitStrash &strash);
 
+    /**
+     * \brief Generates the BDD of one polarity of a node of the structurally hashed circuit graph
+     * \param strash is CircuitStrash
+     * \param literal is CircuitStrash::literal_t of the node and the polarity
+     * \return ClassProject::BDD_ID
+     */
+    ClassProject::BDD_ID GenerateStrashLiteral(const CircuitStrash &strash, CircuitStrash::literal_t literal);
 
     /**
-     * \brief Returns the BDD_ID of the given circuit ID
-     * \param circuit_node is unique_ID_t
+     * \brief Generates the BDD node of a circuit node, whose inputs are already generated
+     * \param circuit is circuit_graph_t
+     * \param node is the position of the node in circuit
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID findBddId(unique_ID_t circuit_node);
+    ClassProject::BDD_ID GenerateNode(const circuit_graph_t &circuit, size_t node);
 
     /**
      * \brief Generates the BDD node equivalent to a variable with label "label".
@@ -77,53 +178,62 @@ private:
 
     /**
      * \brief Generates the BDD node equivalent to the NOT gate.
-     * \param node is set_of_circuit_t containing the circuit ID of the gate to be inverted.
+     * \param first is a pointer to the position of the gate to be inverted.
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID NotGate(const set_of_circuit_t &node);
+    ClassProject::BDD_ID NotGate(const size_t *first);
 
     /**
      * \brief Generates the BDD node equivalent to the AND gate.
-     * \param node is set_of_circuit_t containing the circuit IDs of the gates to be used as input.
+     * \param first, last is the range of positions of the gates to be used as input.
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID AndGate(set_of_circuit_t inputNodes);
+    ClassProject::BDD_ID AndGate(const size_t *first, const size_t *last);
 
     /**
      * \brief Generates the BDD node equivalent to the OR gate.
-     * \param node is set_of_circuit_t containing the circuit IDs of the gates to be used as input.
+     * \param first, last is the range of positions of the gates to be used as input.
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID OrGate(set_of_circuit_t inputNodes);
+    ClassProject::BDD_ID OrGate(const size_t *first, const size_t *last);
 
     /**
      * \brief Generates the BDD node equivalent to the NAND gate.
-     * \param node is set_of_circuit_t containing the circuit IDs of the gates to be used as input.
+     * \param first, last is the range of positions of the gates to be used as input.
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID NandGate(set_of_circuit_t inputNodes);
+    ClassProject::BDD_ID NandGate(const size_t *first, const size_t *last);
 
     /**
      * \brief Generates the BDD node equivalent to the NOR gate.
-     * \param node is set_of_circuit_t containing the circuit IDs of the gates to be used as input.
+     * \param first, last is the range of positions of the gates to be used as input.
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID NorGate(set_of_circuit_t inputNodes);
+    ClassProject::BDD_ID NorGate(const size_t *first, const size_t *last);
 
     /**
      * \brief Generates the BDD node equivalent to the XOR gate.
-     * \param node is set_of_circuit_t containing the circuit IDs of the gates to be used as input.
+     * \param first, last is the range of positions of the gates to be used as input.
      * \return ClassProject::BDD_ID
      *
      */
-    ClassProject::BDD_ID XorGate(set_of_circuit_t inputNodes);
+    ClassProject::BDD_ID XorGate(const size_t *first, const size_t *last);
+
+    /**
+     * \brief Appends all nodes reachable from root that were not visited in the current traversal
+     * \param root is ClassProject::BDD_ID
+     * \param nodes is the list of visited nodes
+     * \return none
+     */
+    void CollectNodes(ClassProject::BDD_ID root, std::vector<ClassProject::BDD_ID> &nodes);
 
-    void dumpBddText(std::ostream &out);
+    void dumpBddText(ResultWriter &out, std::vector<ClassProject::BDD_ID> &nodes);
 
-    void dumpBddDot(std::ostream &out);
+    void dumpBddDot(ResultWriter &out, std::vector<ClassProject::BDD_ID> &nodes,
+                    const std::vector<std::pair<label_t, ClassProject::BDD_ID>> &roots);
 };   
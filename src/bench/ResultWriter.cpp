@@ -0,0 +1,150 @@
+#include "ResultWriter.hpp"
+
+#include <charconv>
+#include <cstdio>
+#include <stdexcept>
+
+
+ResultWriter::ResultWriter(bool background_thread, size_t buffer_size)
+        : buffer_size(buffer_size), background(background_thread) {
+    buffer.reserve(buffer_size);
+    if (background)
+        thread = std::thread(&ResultWriter::Run, this);
+}
+
+ResultWriter::~ResultWriter() {
+    try {
+        if (file_open)
+            Close();
+        Finish();
+    } catch (...) {
+        /* Errors are only reported by Finish */
+    }
+    if (background) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        job_available.notify_one();
+        thread.join();
+    }
+    if (file != nullptr)
+        std::fclose(file);
+}
+
+void ResultWriter::Open(const std::string &path) {
+    if (file_open)
+        Close();
+    pending_path = path;
+    file_open = true;
+}
+
+void ResultWriter::Close() {
+    if (file_open)
+        Submit(true);
+    file_open = false;
+}
+
+void ResultWriter::Finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    job_done.wait(lock, [this] { return jobs.empty() && !busy; });
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+ResultWriter &ResultWriter::operator<<(std::string_view text) {
+    buffer.append(text);
+    if (buffer.size() >= buffer_size)
+        Submit(false);
+    return *this;
+}
+
+ResultWriter &ResultWriter::operator<<(char c) {
+    buffer.push_back(c);
+    if (buffer.size() >= buffer_size)
+        Submit(false);
+    return *this;
+}
+
+ResultWriter &ResultWriter::operator<<(size_t number) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    return *this << std::string_view(digits, result.ptr - digits);
+}
+
+void ResultWriter::Submit(bool close) {
+    Job job = {std::move(pending_path), std::move(buffer), close};
+    pending_path.clear();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    /* Continue with a recycled buffer */
+    if (!free_buffers.empty()) {
+        buffer = std::move(free_buffers.back());
+        free_buffers.pop_back();
+    } else {
+        buffer = std::string();
+        buffer.reserve(buffer_size);
+    }
+
+    if (background) {
+        /* Limit the memory of buffers waiting for the writer */
+        job_done.wait(lock, [this] { return jobs.size() < MAX_PENDING_JOBS; });
+        jobs.push_back(std::move(job));
+        lock.unlock();
+        job_available.notify_one();
+    } else {
+        lock.unlock();
+        Write(job);
+        if (error) {
+            std::exception_ptr e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+void ResultWriter::Write(Job &job) {
+    try {
+        if (!job.path.empty()) {
+            if (file != nullptr)
+                std::fclose(file);
+            file = std::fopen(job.path.c_str(), "wb");
+            if (file == nullptr)
+                throw std::runtime_error("Unable to open " + job.path + "!");
+        }
+        if (file != nullptr && std::fwrite(job.data.data(), 1, job.data.size(), file) != job.data.size())
+            throw std::runtime_error("Unable to write result file!");
+        if (job.close && file != nullptr) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+            error = std::current_exception();
+    }
+
+    job.data.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    free_buffers.push_back(std::move(job.data));
+}
+
+void ResultWriter::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        job_available.wait(lock, [this] { return stop || !jobs.empty(); });
+        if (jobs.empty())
+            return;
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+        Write(job);
+        lock.lock();
+        busy = false;
+        job_done.notify_all();
+    }
+}
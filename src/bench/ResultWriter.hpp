@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+/**
+ * \class ResultWriter
+ *
+ * \brief Buffered writer for result files, optionally writing on a background thread
+ *
+ *  Text is formatted into a large buffer, which is handed over to the writer as soon as it is full. Only the
+ *  file I/O happens on the background thread, so the caller can keep on working, e.g. with a BDD manager, while
+ *  the previous buffer is written. Written buffers are recycled.
+ *
+ */
+class ResultWriter {
+
+public:
+
+    /**
+     * \brief Constructor
+     * \param background_thread true, to write the files on a background thread
+     * \param buffer_size is the size at which a buffer is handed over to the writer
+     */
+    explicit ResultWriter(bool background_thread, size_t buffer_size = 1 << 20);
+
+    /**
+     * \brief Writes all pending buffers and stops the background thread
+     */
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter &) = delete;
+    ResultWriter &operator=(const ResultWriter &) = delete;
+
+    /**
+     * \brief Starts a new file, all following text is written to it
+     * \param path is the path of the file, an existing file is overwritten
+     * \return none
+     */
+    void Open(const std::string &path);
+
+    /**
+     * \brief Hands over the remaining text of the current file to the writer and closes the file
+     * \param none
+     * \return none
+     */
+    void Close();
+
+    /**
+     * \brief Waits until all files are written
+     * \param none
+     * \return none
+     * \throws std::runtime_error if a file could not be written
+     */
+    void Finish();
+
+    ResultWriter &operator<<(std::string_view text);
+
+    ResultWriter &operator<<(char c);
+
+    ResultWriter &operator<<(size_t number);
+
+private:
+
+    /**
+     * \struct Job
+     * \brief Unit of work of the writer: a buffer to append to a file, optionally opening or closing it
+     */
+    struct Job {
+        std::string path;       ///< Path of the file to open before writing, empty to continue the current file
+        std::string data;       ///< Text to write
+        bool close;             ///< true, to close the file after writing
+    };
+
+    static const size_t MAX_PENDING_JOBS = 4; ///< Number of buffers the writer may lag behind
+
+    size_t buffer_size;
+    std::string buffer;         ///< Text of the current file that is not handed over yet
+    std::string pending_path;   ///< File to open with the next job
+    bool file_open = false;
+
+    bool background;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable job_available;
+    std::condition_variable job_done;
+    std::deque<Job> jobs;
+    std::vector<std::string> free_buffers;  ///< Written buffers that are reused
+    std::exception_ptr error;
+    bool busy = false;
+    bool stop = false;
+
+    std::FILE *file = nullptr;
+
+    /**
+     * \brief Hands over the current buffer to the writer
+     * \param close true, to close the file afterwards
+     * \return none
+     */
+    void Submit(bool close);
+
+    /**
+     * \brief Writes a job to its file
+     * \param job is the Job to write
+     * \return none
+     */
+    void Write(Job &job);
+
+    /**
+     * \brief Main loop of the background thread
+     */
+    void Run();
+};
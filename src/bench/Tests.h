@@ -0,0 +1,267 @@
+#ifndef VDSPROJECT_BENCH_TESTS_H
+#define VDSPROJECT_BENCH_TESTS_H
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "../Manager.h"
+#include "BenchParser.hpp"
+#include "CircuitStrash.hpp"
+#include "CircuitToBDD.hpp"
+#include "ResultWriter.hpp"
+
+/* Writes a bench netlist into a temporary file and returns its path */
+static std::string WriteBenchFile(const std::string &name, const std::string &netlist) {
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path, std::ios::trunc) << netlist;
+    return path;
+}
+
+TEST(BenchParser_Test, Backends) { /* NOLINT */
+    // test if both parser backends produce the same circuit graph
+    for (const char *bench_file : {BENCHMARK_DIR "/iscas89/s27.bench", BENCHMARK_DIR "/iscas85/c17.bench"}) {
+        BenchParser spirit(bench_file, false, ParserBackend::Spirit);
+        BenchParser mapped(bench_file, false, ParserBackend::MemoryMapped);
+        const circuit_graph_t &expected = spirit.GetCircuitGraph();
+        const circuit_graph_t &graph = mapped.GetCircuitGraph();
+
+        EXPECT_EQ(graph.ids, expected.ids) << bench_file;
+        EXPECT_EQ(graph.labels, expected.labels) << bench_file;
+        EXPECT_TRUE(graph.gate_types == expected.gate_types) << bench_file;
+        EXPECT_EQ(graph.fanin_offsets, expected.fanin_offsets) << bench_file;
+        EXPECT_EQ(graph.fanin, expected.fanin) << bench_file;
+        EXPECT_EQ(mapped.GetListOfOutputLabels(), spirit.GetListOfOutputLabels()) << bench_file;
+    }
+}
+
+TEST(BenchParser_Test, CircuitGraph) { /* NOLINT */
+    // test if the circuit graph follows the sorted circuit and its fan-in points backwards in ID order
+    BenchParser parser(BENCHMARK_DIR "/iscas85/c17.bench", false);
+    const circuit_graph_t &graph = parser.GetCircuitGraph();
+    list_of_circuit_t circuit = parser.GetSortedCircuit();
+    ASSERT_EQ(graph.size(), circuit.size());
+    ASSERT_EQ(graph.fanin_offsets.size(), graph.size() + 1);
+
+    size_t node = 0;
+    for (const auto &circuit_node : circuit) {
+        EXPECT_EQ(graph.ids[node], circuit_node.id);
+        EXPECT_EQ(graph.labels[node], circuit_node.label);
+        EXPECT_TRUE(graph.gate_types[node] == ToGateType(circuit_node.gate_type));
+        std::set<size_t> fanin_ids;
+        for (size_t j = graph.fanin_offsets[node]; j < graph.fanin_offsets[node + 1]; j++) {
+            EXPECT_LT(graph.fanin[j], node);
+            if (j > graph.fanin_offsets[node]) {
+                EXPECT_LT(graph.ids[graph.fanin[j - 1]], graph.ids[graph.fanin[j]]);
+            }
+            fanin_ids.insert(graph.ids[graph.fanin[j]]);
+        }
+        EXPECT_EQ(fanin_ids, circuit_node.input_id_list);
+        node++;
+    }
+
+    // the cone of output 22 holds the inputs 1, 2, 3, 6 and the gates 10, 11, 16, 22
+    circuit_graph_t cone = parser.GetConeGraph({"22"});
+    EXPECT_EQ(cone.size(), 8);
+    EXPECT_EQ(std::count(cone.labels.begin(), cone.labels.end(), "7"), 0);
+}
+
+TEST(BenchParser_Test, MalformedLines) { /* NOLINT */
+    // test if both parser backends reject a gate with too few inputs and a missing parenthesis
+    std::string one_input = WriteBenchFile("vds_one_input.bench", "INPUT(a)\nOUTPUT(y)\ny = AND(a)\n");
+    std::string open_parenthesis = WriteBenchFile("vds_open_parenthesis.bench",
+                                                  "INPUT(a)\nINPUT(b)\nOUTPUT(y)\ny = AND(a, b\n");
+    for (ParserBackend backend : {ParserBackend::Spirit, ParserBackend::MemoryMapped}) {
+        EXPECT_THROW(BenchParser(one_input, false, backend), std::runtime_error);
+        EXPECT_THROW(BenchParser(open_parenthesis, false, backend), std::runtime_error);
+    }
+    std::filesystem::remove(one_input);
+    std::filesystem::remove(open_parenthesis);
+}
+
+TEST(BenchParser_Test, CrlfAndBlankLines) { /* NOLINT */
+    // test if the memory-mapped backend tolerates CRLF line endings and blank lines
+    std::string bench_file = WriteBenchFile("vds_crlf.bench",
+                                            "INPUT(a)\r\n\r\nINPUT(b)\r\nOUTPUT(y)\r\n\r\ny = NAND(a, b)\r\n");
+    BenchParser mapped(bench_file, false, ParserBackend::MemoryMapped);
+    EXPECT_EQ(mapped.GetCircuitGraph().size(), 4);
+    EXPECT_EQ(mapped.GetListOfOutputLabels(), std::set<label_t>({"y"}));
+    std::filesystem::remove(bench_file);
+}
+
+/* Returns the position of the gate with the given label, skipping OUTPUT nodes */
+static size_t GatePosition(const circuit_graph_t &circuit, const label_t &label) {
+    for (size_t node = 0; node < circuit.size(); node++) {
+        if (circuit.labels[node] == label && circuit.gate_types[node] != gate_type_t::Output)
+            return node;
+    }
+    throw std::runtime_error("There is no gate " + label + "!");
+}
+
+TEST(CircuitStrash_Test, Hashing) { /* NOLINT */
+    // test if duplicate gates are merged, buffers and inverters become edges and constants are propagated
+    std::string bench_file = WriteBenchFile("vds_hashing.bench",
+                                            "INPUT(a)\nINPUT(b)\nINPUT(c)\n"
+                                            "OUTPUT(g1)\nOUTPUT(g2)\nOUTPUT(g3)\nOUTPUT(n2)\n"
+                                            "OUTPUT(x)\nOUTPUT(z1)\nOUTPUT(z2)\nOUTPUT(o)\n"
+                                            "g1 = AND(a, b)\ng2 = AND(b, a)\ng3 = NAND(a, b)\n"
+                                            "b1 = BUFF(c)\nb2 = BUFF(b1)\nn1 = NOT(b2)\nn2 = NOT(n1)\n"
+                                            "x = XOR(a, b1)\n"
+                                            "ba = BUFF(a)\nz1 = XOR(a, ba)\n"
+                                            "na = NOT(a)\nz2 = AND(a, na)\no = OR(a, na)\n");
+    BenchParser parser(bench_file, false);
+    std::filesystem::remove(bench_file);
+    const circuit_graph_t &circuit = parser.GetCircuitGraph();
+    CircuitStrash strash(circuit);
+    auto literal = [&](const label_t &label) { return strash.GetLiteral(GatePosition(circuit, label)); };
+
+    // the constant, three inputs, one AND and one XOR node remain
+    EXPECT_EQ(strash.Size(), 6);
+    EXPECT_LT(strash.Size(), circuit.size());
+    EXPECT_TRUE(strash.GetGateType(literal("g1") >> 1) == gate_type_t::And);
+    EXPECT_TRUE(strash.GetGateType(literal("x") >> 1) == gate_type_t::Xor);
+
+    EXPECT_EQ(literal("g2"), literal("g1"));
+    EXPECT_EQ(literal("g3"), literal("g1") ^ 1);
+    EXPECT_EQ(literal("b2"), literal("c"));
+    EXPECT_EQ(literal("n1"), literal("c") ^ 1);
+    EXPECT_EQ(literal("n2"), literal("c"));
+    EXPECT_EQ(literal("z1"), 0);
+    EXPECT_EQ(literal("z2"), 0);
+    EXPECT_EQ(literal("o"), 1);
+
+    auto fanin = strash.GetFanIn(literal("x") >> 1);
+    EXPECT_EQ(std::vector<CircuitStrash::literal_t>(fanin.first, fanin.second),
+              std::vector<CircuitStrash::literal_t>({literal("a"), literal("c")}));
+}
+
+/* Builds the circuit once plainly and once structurally hashed in the same manager and compares the outputs */
+static void ExpectSameBddWithStrash(BenchParser &parser) {
+    const circuit_graph_t &circuit = parser.GetCircuitGraph();
+    auto manager = std::make_shared<ClassProject::Manager>();
+    CircuitToBDD plain(manager);
+    plain.GenerateBDD(circuit);
+
+    CircuitToBDD hashed(manager);
+    hashed.SetStructuralHashing(true);
+    for (size_t node = 0; node < circuit.size(); node++) {
+        if (circuit.gate_types[node] == gate_type_t::Input)
+            hashed.BindInput(circuit.labels[node], plain.GetBddId(circuit.labels[node]));
+    }
+    hashed.GenerateBDD(circuit);
+
+    for (const auto &label : parser.GetListOfOutputLabels())
+        EXPECT_EQ(hashed.GetBddId(label), plain.GetBddId(label)) << label;
+}
+
+TEST(CircuitToBDD_Test, StructuralHashing) { /* NOLINT */
+    // test if structural hashing yields the same BDD for every output
+    BenchParser s27(BENCHMARK_DIR "/iscas89/s27.bench", false);
+    ExpectSameBddWithStrash(s27);
+
+    std::string bench_file = WriteBenchFile("vds_strash.bench",
+                                            "INPUT(a)\nINPUT(b)\nINPUT(c)\nINPUT(d)\n"
+                                            "OUTPUT(x1)\nOUTPUT(x2)\nOUTPUT(x3)\nOUTPUT(x4)\n"
+                                            "OUTPUT(x5)\nOUTPUT(x6)\nOUTPUT(x7)\n"
+                                            "ba = BUFF(a)\nna = NOT(a)\nnb = NOT(b)\nnc = NOT(c)\n"
+                                            "x1 = XOR(a, ba)\n"           // a ^ a = 0
+                                            "x2 = AND(a, na, c)\n"        // a & !a = 0
+                                            "x3 = OR(nb, nc)\n"           // inverted inputs
+                                            "x4 = NOR(nb, nc)\n"
+                                            "n = NAND(a, d)\nnn = NOT(n)\n"
+                                            "x5 = AND(n, b)\n"            // NAND in both polarities
+                                            "x6 = OR(nn, c)\n"
+                                            "x7 = XOR(na, d)\n");         // complemented XOR input
+    BenchParser netlist(bench_file, false);
+    std::filesystem::remove(bench_file);
+    ExpectSameBddWithStrash(netlist);
+}
+
+/* Returns the contents of a file */
+static std::string ReadFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+/* Writes two files through a writer with a tiny buffer, so that every file spans several buffers */
+static void ExpectWrittenFiles(bool background_thread) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::string first = (dir / "vds_writer_first.txt").string();
+    std::string second = (dir / "vds_writer_second.txt").string();
+    std::string expected_first, expected_second;
+    {
+        ResultWriter writer(background_thread, 16);
+        writer.Open(first);
+        for (size_t i = 0; i < 100; i++) {
+            writer << i << ',' << "node" << '\n';
+            expected_first += std::to_string(i) + ",node\n";
+        }
+        writer.Open(second);
+        writer << "single line";
+        expected_second = "single line";
+        writer.Close();
+        writer.Finish();
+        EXPECT_EQ(ReadFile(first), expected_first);
+        EXPECT_EQ(ReadFile(second), expected_second);
+
+        // a reopened file is overwritten
+        writer.Open(first);
+        writer << size_t(42);
+        writer.Close();
+        writer.Finish();
+        EXPECT_EQ(ReadFile(first), "42");
+    }
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST(ResultWriter_Test, Synchronous) { /* NOLINT */
+    // test if the writer writes the files on the calling thread
+    ExpectWrittenFiles(false);
+}
+
+TEST(ResultWriter_Test, Background) { /* NOLINT */
+    // test if the writer writes the files on its background thread
+    ExpectWrittenFiles(true);
+}
+
+TEST(ResultWriter_Test, UnwritablePath) { /* NOLINT */
+    // test if a file that cannot be opened is reported
+    std::string path = (std::filesystem::temp_directory_path() / "vds_missing_dir" / "file.txt").string();
+    for (bool background_thread : {false, true}) {
+        ResultWriter writer(background_thread);
+        writer.Open(path);
+        writer << "text";
+        EXPECT_THROW({
+            writer.Close();
+            writer.Finish();
+        }, std::runtime_error);
+        // the error is reported once
+        EXPECT_NO_THROW(writer.Finish());
+    }
+}
+
+TEST(CircuitToBDD_Test, UnwritableCsv) { /* NOLINT */
+    // test if GenerateBDD reports a BNode_BDD.csv that cannot be written
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::string bench_file = WriteBenchFile("vds_unwritable.bench", "INPUT(a)\nINPUT(b)\nOUTPUT(y)\ny = AND(a, b)\n");
+    std::filesystem::path cwd = std::filesystem::current_path();
+    std::filesystem::current_path(dir);
+    /* A directory in place of the CSV cannot be opened as a file */
+    std::filesystem::create_directories(dir / "results_vds_unwritable" / "BNode_BDD.csv");
+
+    BenchParser parser(bench_file, false);
+    for (bool background_thread : {false, true}) {
+        CircuitToBDD circuit2BDD(std::make_shared<ClassProject::Manager>(), background_thread);
+        EXPECT_THROW(circuit2BDD.GenerateBDD(parser.GetCircuitGraph(), bench_file), std::runtime_error);
+    }
+
+    std::filesystem::current_path(cwd);
+    std::filesystem::remove_all(dir / "results_vds_unwritable");
+    std::filesystem::remove(bench_file);
+}
+
+#endif
@@ -4,6 +4,7 @@
 //
 
 #include <iostream>
+#include <sstream>
 #include <string>
 
 #include "Manager.h"
@@ -11,36 +12,106 @@
 #include "CircuitToBDD.hpp"
 #include "BenchmarkLib.h"
 
+static void printUsage(const char *program) {
+    std::cout << "Usage: " << program << " <bench_file> [options]" << std::endl
+              << "Options:" << std::endl
+              << "  --outputs <l1,l2,...>  build and print only the cones of the given outputs" << std::endl
+              << "  --no-output            do not write any result files" << std::endl
+              << "  --stats-only           print only statistics, implies --no-output" << std::endl
+              << "  --combined             write one combined txt and dot file for all outputs" << std::endl
+              << "  --background-writer    write the result files on a background thread" << std::endl
+              << "  --mmap-parser          parse the bench file with the memory-mapped parser" << std::endl
+              << "  --strash               hash the circuit structurally before generating the BDD" << std::endl;
+}
+
 int main(int argc, char *argv[]) {
 
     if (2 > argc) {
         std::cout << "Must specify a filename!" << std::endl;
+        printUsage(argv[0]);
         return -1;
     }
 
     std::string bench_file = argv[1];
+    std::set<label_t> selected_outputs;
+    bool file_output = true;
+    bool stats_only = false;
+    bool combined = false;
+    bool background_writer = false;
+    ParserBackend parser_backend = ParserBackend::Spirit;
+    bool structural_hashing = false;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--outputs" && i + 1 < argc) {
+            std::stringstream labels(argv[++i]);
+            for (std::string label; std::getline(labels, label, ',');) {
+                if (!label.empty())
+                    selected_outputs.insert(label);
+            }
+        } else if (option == "--no-output") {
+            file_output = false;
+        } else if (option == "--stats-only") {
+            stats_only = true;
+            file_output = false;
+        } else if (option == "--combined") {
+            combined = true;
+        } else if (option == "--background-writer") {
+            background_writer = true;
+        } else if (option == "--mmap-parser") {
+            parser_backend = ParserBackend::MemoryMapped;
+        } else if (option == "--strash") {
+            structural_hashing = true;
+        } else {
+            std::cout << "Unknown option: " << option << std::endl;
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
 
     /* Parse the circuit from file and generate topological sorted circuit */
-    BenchParser parsed_circuit(bench_file);
+    BenchParser parsed_circuit(bench_file, !stats_only, parser_backend);
+
+    std::set<label_t> output_labels = parsed_circuit.GetListOfOutputLabels();
+    for (const auto &label : selected_outputs) {
+        if (output_labels.count(label) == 0) {
+            std::cout << "Unknown output: " << label << std::endl;
+            return -1;
+        }
+    }
+    if (!selected_outputs.empty())
+        output_labels = selected_outputs;
+    circuit_graph_t circuit = selected_outputs.empty() ? parsed_circuit.GetCircuitGraph()
+                                                       : parsed_circuit.GetConeGraph(selected_outputs);
 
     auto BDD_manager = make_shared<ClassProject::Manager>();
-    auto circuit2BDD = make_unique<CircuitToBDD>(BDD_manager);
+    auto circuit2BDD = make_unique<CircuitToBDD>(BDD_manager, background_writer);
+    circuit2BDD->SetCombinedOutput(combined);
+    circuit2BDD->SetStructuralHashing(structural_hashing);
 
     double user_time, vm1, rss1, vm2, rss2;
 
-    std::cout << "- Generating BDD from circuit...";
+    if (!stats_only)
+        std::cout << "- Generating BDD from circuit...";
     process_mem_usage(vm1, rss1);
     user_time = userTime();
-    circuit2BDD->GenerateBDD(parsed_circuit.GetSortedCircuit(), bench_file);
+    if (file_output)
+        circuit2BDD->GenerateBDD(circuit, bench_file);
+    else
+        circuit2BDD->GenerateBDD(circuit);
     user_time = userTime() - user_time;
-    std::cout << " BDD generated successfully!" << std::endl << std::endl;
+    if (!stats_only)
+        std::cout << " BDD generated successfully!" << std::endl << std::endl;
 
-    circuit2BDD->PrintBDD(parsed_circuit.GetListOfOutputLabels());
+    if (file_output)
+        circuit2BDD->PrintBDD(output_labels);
 
     std::cout << "**** Performance ****" << std::endl;
     std::cout << " Runtime: " << user_time << std::endl;
     process_mem_usage(vm2, rss2);
-    std::cout << " VM: " << vm2 - vm1 << "; RSS: " << rss2 - rss1 << endl << endl;
+    std::cout << " VM: " << vm2 - vm1 << "; RSS: " << rss2 - rss1 << endl;
+    std::cout << " Gates: " << circuit.size() << "; Outputs: " << output_labels.size()
+              << "; BDD nodes: " << BDD_manager->uniqueTableSize() << endl << endl;
 
     return 0;
 }
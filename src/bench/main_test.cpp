@@ -0,0 +1,12 @@
+//
+// Created by ludwig on 22.11.16.
+//
+
+#include "Tests.h"
+
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
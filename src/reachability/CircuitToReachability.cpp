@@ -0,0 +1,65 @@
+#include "CircuitToReachability.hpp"
+
+
+CircuitToReachability::CircuitToReachability(const list_of_circuit_t &circuit) {
+    std::map<label_t, label_t> next_state_labels;  // FLIP FLOP label -> label of its input
+    std::set<label_t> inputs;
+    std::unordered_map<unique_ID_t, label_t> id_to_label;
+
+    for (const auto &circuit_node : circuit) {
+        id_to_label.insert(std::pair<unique_ID_t, label_t>(circuit_node.id, circuit_node.label));
+        if (circuit_node.gate_type == INPUT_GATE_T) {
+            inputs.insert(circuit_node.label);
+        } else if (circuit_node.gate_type == FLIP_FLOP_GATE_T) {
+            /* The input of the FLIP FLOP precedes it in the sorted circuit */
+            next_state_labels.insert(std::pair<label_t, label_t>(
+                    circuit_node.label, id_to_label.at(*circuit_node.input_id_list.begin())));
+        }
+    }
+
+    if (next_state_labels.empty())
+        throw std::runtime_error("The circuit must contain at least one FLIP FLOP!");
+
+    /* INPUT gates of FLIP FLOPs are the current state, all others are primary inputs */
+    for (const auto &next_state_label : next_state_labels) {
+        state_labels.push_back(next_state_label.first);
+        inputs.erase(next_state_label.first);
+    }
+    input_labels.assign(inputs.begin(), inputs.end());
+
+    reachability = std::make_shared<ClassProject::Reachability>(state_labels.size(), input_labels.size());
+    circuit_to_bdd = std::make_unique<CircuitToBDD>(reachability);
+
+    /* Bind the INPUT gates to the variables of the Reachability instance instead of creating new ones */
+    const std::vector<ClassProject::BDD_ID> &states = reachability->getStates();
+    const std::vector<ClassProject::BDD_ID> &input_vars = reachability->getInputs();
+    for (size_t i = 0; i < state_labels.size(); i++)
+        circuit_to_bdd->BindInput(state_labels[i], states[i]);
+    for (size_t i = 0; i < input_labels.size(); i++)
+        circuit_to_bdd->BindInput(input_labels[i], input_vars[i]);
+
+    circuit_to_bdd->GenerateBDD(circuit);
+
+    std::vector<ClassProject::BDD_ID> transition_functions;
+    for (const auto &next_state_label : next_state_labels)
+        transition_functions.push_back(circuit_to_bdd->GetBddId(next_state_label.second));
+    reachability->setTransitionFunctions(transition_functions);
+}
+
+CircuitToReachability::~CircuitToReachability() = default;
+
+std::shared_ptr<ClassProject::Reachability> CircuitToReachability::GetReachability() {
+    return reachability;
+}
+
+const std::vector<label_t> &CircuitToReachability::GetStateLabels() {
+    return state_labels;
+}
+
+const std::vector<label_t> &CircuitToReachability::GetInputLabels() {
+    return input_labels;
+}
+
+ClassProject::BDD_ID CircuitToReachability::GetBddId(const label_t &label) {
+    return circuit_to_bdd->GetBddId(label);
+}
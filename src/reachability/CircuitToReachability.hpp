@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Reachability.h"
+#include "BenchParser.hpp"
+#include "CircuitToBDD.hpp"
+
+#include <memory>
+
+
+/**
+ * \class CircuitToReachability
+ *
+ * \brief Class to convert a sequential circuit into a Reachability instance
+ *
+ *  The circuit nodes are generated by BenchParser, which splits every FLIP FLOP into an INPUT gate (the current state)
+ *  and a FLIP FLOP gate driven by the next state function. Each FLIP FLOP becomes a state bit, all other INPUT gates
+ *  become inputs. The next state functions are built directly in the Manager of the Reachability instance.
+ *
+ */
+class CircuitToReachability {
+
+public:
+
+    /**
+     * \brief Builds the state and input variables and the next state functions of the circuit
+     * \param circuit Topologically sorted list containing the circuit nodes
+     *
+     *  The state bits are ordered by the labels of the FLIP FLOPs, the inputs by the labels of the INPUT gates.
+     *  The initial state is all-false.
+     */
+    explicit CircuitToReachability(const list_of_circuit_t &circuit);
+    ~CircuitToReachability();
+
+    /**
+     * \brief return the Reachability instance of the circuit
+     * \param none
+     * \return shared_ptr<ClassProject::Reachability>
+     *
+     */
+    std::shared_ptr<ClassProject::Reachability> GetReachability();
+
+    /**
+     * \brief return the labels of the FLIP FLOPs in the order of the state bits
+     * \param none
+     * \return std::vector<label_t>
+     *
+     */
+    const std::vector<label_t> &GetStateLabels();
+
+    /**
+     * \brief return the labels of the primary inputs in the order of the inputs
+     * \param none
+     * \return std::vector<label_t>
+     *
+     */
+    const std::vector<label_t> &GetInputLabels();
+
+    /**
+     * \brief return the BDD_ID of the gate with the given label
+     * \param label is label_t
+     * \return ClassProject::BDD_ID
+     *
+     *  Gates are functions of the current state and input variables, e.g. primary outputs.
+     */
+    ClassProject::BDD_ID GetBddId(const label_t &label);
+
+private:
+
+    std::shared_ptr<ClassProject::Reachability> reachability;
+    std::unique_ptr<CircuitToBDD> circuit_to_bdd;
+
+    std::vector<label_t> state_labels;  ///< Labels of the FLIP FLOPs, i.e. the state bits
+    std::vector<label_t> input_labels;  ///< Labels of the primary inputs
+};
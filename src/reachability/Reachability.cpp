@@ -12,17 +12,21 @@ namespace ClassProject {
         for (unsigned long input = 0; input < inputSize; input++)
             addInput();
 
-        // initialize initial state vector
-        for (int i = 0; i < stateSize; i++)
-            initial_states.push_back(Manager::False());
+        // initialize initial state to all-false
+        std::vector<BDD_ID> initial_state(stateSize, False());
+        initial_states = characteristicFunction(current_states, initial_state);
 
         // initialize transition functions
         for (BDD_ID state: current_states)
             trans_function.push_back(state); // set to identity function
+
+        // all partitions of the transition relation are built on first use
+        relation_partitions.assign(2 * stateSize, True());
+        for (unsigned long i = 0; i < stateSize; i++)
+            stale_partitions.insert(i);
     }
 
     bool Reachability::isReachable(const std::vector<bool> &stateVector) {
-        iteration_results.clear();
         std::vector<BDD_ID> vec(stateVector.size());
 
         // check dimensions
@@ -32,32 +36,28 @@ namespace ClassProject {
         for (unsigned long i = 0; i < current_states.size(); i++)
             vec[i] = stateVector[i] ? True() : False();
 
-        BDD_ID tau = transitionRelation(current_states, inputs, next_states);
-        BDD_ID cs0 = characteristicFunction(current_states, initial_states);
-        iteration_results.push_back(cs0);
-
-        BDD_ID cR, cR_it;
-        cR_it = cs0;
-        do {
-            cR = cR_it;
-            // imgR(s') := ∃x ∃s cR(s) ⋅ τ(s, x, s');
-            BDD_ID imgRsp = existentialQuantification(existentialQuantification(and2(cR, tau), current_states), inputs);
-            // form imgR(s) by renaming of variables s' into s;
-            // imgR(s) = ∃s' (s == s') ⋅ imgR(s')
-            BDD_ID imgR = existentialQuantification(and2(characteristicFunction(current_states, next_states), imgRsp),
-                                                    next_states);
-            // calculate newly reached states
-            iteration_results.push_back(and2(imgR, neg(cR)));
-
-            cR_it = or2(cR, imgR);
-        } while (cR != cR_it);
-
-        computation_required = false;
-        return evaluateCharacteristicFunction(cR, vec) == True();
+        switch (search_strategy) {
+            case SearchStrategy::Backward:
+                return backwardSearch(characteristicFunction(current_states, vec));
+            case SearchStrategy::Bidirectional:
+                return bidirectionalSearch(characteristicFunction(current_states, vec));
+            default:
+                if (reachability_engine != ReachabilityEngine::BreadthFirst)
+                    return evaluateCharacteristicFunction(reachableStates(), vec);
+                // states of the onion rings computed so far
+                if (evaluateCharacteristicFunction(getFixpointState().reached, vec))
+                    return true;
+                // continue the fixpoint only until the state is found
+                while (step()) {
+                    if (evaluateCharacteristicFunction(fixpoint.frontier, vec))
+                        return true;
+                }
+                return false;
+        }
     }
 
     int Reachability::stateDistance(const std::vector<bool> &stateVector) {
-        std::vector<BDD_ID> vec(initial_states.size());
+        std::vector<BDD_ID> vec(stateVector.size());
 
         // check dimensions
         if (current_states.size() != stateVector.size())
@@ -65,17 +65,168 @@ namespace ClassProject {
         // convert boolean data type to BDD_ID boolean data type
         for (int i = 0; i < current_states.size(); i++)
             vec[i] = stateVector[i] ? True() : False();
-        // run reachability algorithm to create iteration table
-        if (computation_required)
-            isReachable(stateVector);
+        // single walk through the distance ADD
+        if (distance_folding)
+            return static_cast<int>(addEvaluate(distanceAdd(), current_states, stateVector));
+        // search the onion rings computed so far
+        getFixpointState();
+        for (size_t i = 0; i < fixpoint.rings.size(); i++) {
+            if (evaluateCharacteristicFunction(fixpoint.rings[i], vec))
+                return static_cast<int>(i);
+        }
+        // continue the fixpoint only until the state is found
+        while (step()) {
+            if (evaluateCharacteristicFunction(fixpoint.frontier, vec))
+                return static_cast<int>(fixpoint.rings.size()) - 1;
+        }
+        return -1;
+    }
+
+    /**
+     * Decides whether a state can be reached from the initial state within at most k transitions. Only the onion rings
+     * up to depth k are computed, rings from earlier queries are reused.
+     * @param stateVector State to check
+     * @param k Maximum number of transitions
+     * @return true, if the state has a distance of at most k
+     * @throws std::runtime_error if the size of stateVector does not match the number of state bits
+     */
+    bool Reachability::isReachableWithin(const std::vector<bool> &stateVector, unsigned int k) {
+        std::vector<BDD_ID> vec(stateVector.size());
 
-        for (int i = 0; i < iteration_results.size(); i++) {
-            if (evaluateCharacteristicFunction(iteration_results[i], vec) == True())
-                return i;
+        // check dimensions
+        if (current_states.size() != stateVector.size())
+            throw std::runtime_error("State space and dimension of given current_states do not match.");
+        // convert boolean data type to BDD_ID boolean data type
+        for (unsigned long i = 0; i < current_states.size(); i++)
+            vec[i] = stateVector[i] ? True() : False();
+        // search the onion rings computed so far
+        const FixpointState &state = getFixpointState();
+        for (unsigned int i = 0; i < state.rings.size() && i <= k; i++) {
+            if (evaluateCharacteristicFunction(state.rings[i], vec))
+                return true;
+        }
+        // continue the fixpoint only up to depth k
+        while (state.rings.size() <= k && step()) {
+            if (evaluateCharacteristicFunction(state.frontier, vec))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Returns the states reachable from the initial state within at most k transitions. Only the onion rings up to
+     * depth k are computed, rings from earlier queries are reused.
+     * @param k Maximum number of transitions
+     * @return Characteristic function of the states with a distance of at most k
+     */
+    BDD_ID Reachability::reachableSetAtDepth(unsigned int k) {
+        runUntil(k);
+        // all rings computed so far are within the bound
+        if (fixpoint.rings.size() - 1 <= k)
+            return fixpoint.reached;
+        BDD_ID states = False();
+        for (unsigned int i = 0; i <= k; i++)
+            states = or2(states, fixpoint.rings[i]);
+        return states;
+    }
+
+    /**
+     * Checks whether a property holds in all states reachable from the initial state. Every new frontier is tested
+     * against the property and the fixpoint stops at the first violation.
+     * @param property Characteristic function of the allowed states over the current state variables
+     * @return Distance of the closest violating state from the initial state, -1 if the invariant holds
+     * @throws std::runtime_error if property is no valid BDD over the current state variables
+     */
+    int Reachability::checkInvariant(BDD_ID property) {
+        checkStateSet(property);
+        const FixpointState &state = getFixpointState();
+        // search the onion rings computed so far
+        for (unsigned int i = 0; i < state.rings.size(); i++) {
+            if (!leq(state.rings[i], property))
+                return static_cast<int>(i);
+        }
+        // continue the fixpoint only until a violating state is found
+        while (step()) {
+            if (!leq(state.frontier, property))
+                return static_cast<int>(state.rings.size()) - 1;
         }
         return -1;
     }
 
+    /**
+     * Enables or disables folding the onion rings into a distance ADD. If enabled, stateDistance completes the
+     * fixpoint once and then answers every query by a single walk through the distance ADD instead of searching the
+     * onion rings.
+     * @param enable true, to answer stateDistance from the distance ADD
+     */
+    void Reachability::setDistanceFolding(bool enable) {
+        distance_folding = enable;
+    }
+
+    /**
+     * Returns an ADD over the state bits that maps every state to its distance from the initial state, and every
+     * unreachable state to -1. The fixpoint is completed and the onion rings are folded once.
+     * @return Distance ADD
+     */
+    ADD_ID Reachability::distanceAdd() {
+        runToFixpoint();
+        if (!distance_add_complete) {
+            // the onion rings are disjoint, so folding them in any order labels each state with its ring
+            distance_add = addConstant(-1);
+            for (size_t i = 0; i < fixpoint.rings.size(); i++)
+                distance_add = addIte(fixpoint.rings[i], addConstant(static_cast<ADD_Value>(i)), distance_add);
+            distance_add_complete = true;
+        }
+        return distance_add;
+    }
+
+    /**
+     * Returns the number of states per distance from the initial state. Unreachable states are counted at distance -1.
+     * @return Number of states per distance
+     */
+    std::map<ADD_Value, BigCount> Reachability::distanceDistribution() {
+        return addTerminalCounts(distanceAdd(), current_states.size());
+    }
+
+    /**
+     * Returns a shortest trace from the initial state to the given state. The onion rings are walked backwards: each
+     * predecessor is picked from the pre-image of the following state restricted to the previous ring, and the inputs
+     * are picked from the transition relation restricted to both states.
+     * @param stateVector State to reach
+     * @return Trace with distance + 1 states and distance inputs, an empty trace if the state is unreachable
+     * @throws std::runtime_error if the size of stateVector does not match the number of state bits
+     */
+    Trace Reachability::traceTo(const std::vector<bool> &stateVector) {
+        Trace trace;
+        int distance = stateDistance(stateVector);
+        if (distance < 0)
+            return trace;
+
+        trace.states.resize(distance + 1);
+        trace.inputs.resize(distance);
+        trace.states[distance] = stateVector;
+        for (int i = distance - 1; i >= 0; i--) {
+            const std::vector<bool> &successor = trace.states[i + 1];
+            std::vector<BDD_ID> vec(successor.size());
+            for (unsigned long j = 0; j < successor.size(); j++)
+                vec[j] = successor[j] ? True() : False();
+            // predecessors of the successor with distance i
+            BDD_ID predecessors = and2(preImage(characteristicFunction(current_states, vec), transition_relation),
+                                       fixpoint.rings[i]);
+            trace.states[i] = pickOneMinterm(predecessors, current_states);
+            // inputs that lead from the predecessor to the successor
+            BDD_ID transitionInputs = transition_relation;
+            for (unsigned long j = 0; j < current_states.size(); j++) {
+                transitionInputs = trace.states[i][j] ? coFactorTrue(transitionInputs, current_states[j])
+                                                      : coFactorFalse(transitionInputs, current_states[j]);
+                transitionInputs = successor[j] ? coFactorTrue(transitionInputs, next_states[j])
+                                                : coFactorFalse(transitionInputs, next_states[j]);
+            }
+            trace.inputs[i] = pickOneMinterm(transitionInputs, inputs);
+        }
+        return trace;
+    }
+
     void Reachability::setTransitionFunctions(const std::vector<BDD_ID> &transitionFunctions) {
         // check dimensions
         if (transitionFunctions.size() != current_states.size())
@@ -87,7 +238,33 @@ namespace ClassProject {
                 throw std::runtime_error("Invalid transition function. Invalid BDD ID found.");
         }
 
+        // only partitions of changed transition functions are rebuilt
+        for (unsigned long i = 0; i < transitionFunctions.size(); i++) {
+            if (trans_function[i] != transitionFunctions[i])
+                stale_partitions.insert(i);
+        }
         trans_function = transitionFunctions;
+        computation_required = true;
+    }
+
+    /**
+     * Replaces the transition function of a single state bit. Only the partition of the transition relation that
+     * belongs to this state bit is rebuilt, all other partitions are reused.
+     * @param stateIndex            Index of the state bit
+     * @param transitionFunction    New next state function of the state bit
+     * @throws std::runtime_error if the index or the transition function is invalid
+     */
+    void Reachability::updateTransitionFunction(unsigned int stateIndex, BDD_ID transitionFunction) {
+        if (stateIndex >= current_states.size())
+            throw std::runtime_error("Invalid state index.");
+        if (transitionFunction >= uniqueTableSize())
+            throw std::runtime_error("Invalid transition function. Invalid BDD ID found.");
+
+        if (trans_function[stateIndex] != transitionFunction) {
+            trans_function[stateIndex] = transitionFunction;
+            stale_partitions.insert(stateIndex);
+        }
+        computation_required = true;
     }
 
     void Reachability::setInitState(const std::vector<bool> &stateVector) {
@@ -96,12 +273,53 @@ namespace ClassProject {
             throw std::runtime_error("State space and dimension of initial current_states do not match.");
 
         // convert boolean data type to BDD_ID boolean data type
+        std::vector<BDD_ID> vec(stateVector.size());
         for (unsigned long i = 0; i < stateVector.size(); i++)
-            initial_states[i] = stateVector[i] ? True() : False();
+            vec[i] = stateVector[i] ? True() : False();
+        initial_states = characteristicFunction(current_states, vec);
 
         computation_required = true;
     }
 
+    /**
+     * Sets the initial states to an arbitrary set of states, so a single fixpoint covers all of them
+     * @param states Characteristic function of the initial states over the current state variables
+     * @throws std::runtime_error if states is no valid BDD over the current state variables
+     */
+    void Reachability::setInitStateSet(BDD_ID states) {
+        checkStateSet(states);
+        initial_states = states;
+        computation_required = true;
+    }
+
+    /**
+     * Decides whether any state of a set of target states can be reached from the initial states
+     * @param states Characteristic function of the target states over the current state variables
+     * @return true, if at least one target state is reachable
+     * @throws std::runtime_error if states is no valid BDD over the current state variables
+     */
+    bool Reachability::isSetReachable(BDD_ID states) {
+        checkStateSet(states);
+        switch (search_strategy) {
+            case SearchStrategy::Backward:
+                return backwardSearch(states);
+            case SearchStrategy::Bidirectional:
+                return bidirectionalSearch(states);
+            default:
+                if (reachability_engine != ReachabilityEngine::BreadthFirst)
+                    return intersects(reachableStates(), states);
+                // states of the onion rings computed so far
+                if (intersects(getFixpointState().reached, states))
+                    return true;
+                // continue the fixpoint only until a target state is found
+                while (step()) {
+                    if (intersects(fixpoint.frontier, states))
+                        return true;
+                }
+                return false;
+        }
+    }
+
     const std::vector<BDD_ID> &Reachability::getStates() const {
         return current_states;
     }
@@ -110,6 +328,185 @@ namespace ClassProject {
         return inputs;
     }
 
+    /**
+     * Performs one iteration of the forward fixpoint, resuming from the state the last query left it in. Only the
+     * frontier, i.e. the states reached in the last iteration, is imaged. The newly reached states are stored as the
+     * next onion ring.
+     * @return false, if the fixpoint is reached and no new states were found
+     */
+    bool Reachability::step() {
+        if (computation_required)
+            resetFixpoint();
+        if (fixpoint.converged)
+            return false;
+        fixpoint.steps++;
+        BDD_ID frontier = fixpoint.frontier;
+        // states reached before the last iteration are don't cares, their successors are already reached
+        if (frontier_minimization)
+            frontier = restrict(frontier, or2(frontier, neg(fixpoint.reached)));
+        BDD_ID imgR = image(frontier, transition_relation);
+        // fixpoint is reached, if no new states are found
+        if (leq(imgR, fixpoint.reached)) {
+            fixpoint.converged = true;
+            return false;
+        }
+        // calculate newly reached states
+        fixpoint.frontier = and2(imgR, neg(fixpoint.reached));
+        fixpoint.rings.push_back(fixpoint.frontier);
+        fixpoint.reached = or2(fixpoint.reached, fixpoint.frontier);
+        return true;
+    }
+
+    /**
+     * Continues the fixpoint iteration until the onion rings cover all states with at most the given distance from
+     * the initial state, or the fixpoint is reached
+     * @param depth Distance from the initial state
+     */
+    void Reachability::runUntil(unsigned int depth) {
+        while (getFixpointState().rings.size() <= depth && step());
+    }
+
+    /**
+     * Completes the fixpoint iteration, resuming from the onion rings computed so far
+     */
+    void Reachability::runToFixpoint() {
+        while (step());
+    }
+
+    /**
+     * Returns the current state of the forward fixpoint iteration. It is restarted from the initial state, if the
+     * transition functions or the initial state changed.
+     * @return State of the fixpoint iteration
+     */
+    const FixpointState &Reachability::getFixpointState() {
+        if (computation_required)
+            resetFixpoint();
+        return fixpoint;
+    }
+
+    /**
+     * Returns all states reachable from the initial state, computed by the selected engine. A completed breadth-first
+     * fixpoint is reused by the other engines.
+     * @return Characteristic function of the reachable states
+     */
+    BDD_ID Reachability::reachableStates() {
+        if (reachability_engine == ReachabilityEngine::BreadthFirst || getFixpointState().converged) {
+            runToFixpoint();
+            return fixpoint.reached;
+        }
+        if (!engine_complete) {
+            engine_states = reachability_engine == ReachabilityEngine::Saturation ? saturate() : chain();
+            engine_complete = true;
+        }
+        return engine_states;
+    }
+
+    /**
+     * Returns the number of states reachable from the initial state.
+     * @return Number of reachable states
+     */
+    BigCount Reachability::reachableStateCount() {
+        return satCount(reachableStates(), current_states.size());
+    }
+
+    /**
+     * Returns the number of newly reached states of each fixpoint iteration. The first entry corresponds to the
+     * initial state.
+     * @return Number of new states per iteration
+     */
+    std::vector<BigCount> Reachability::newStatesPerIteration() {
+        runToFixpoint();
+        std::vector<BigCount> counts;
+        counts.reserve(fixpoint.rings.size());
+        for (BDD_ID ring: fixpoint.rings)
+            counts.push_back(satCount(ring, current_states.size()));
+        return counts;
+    }
+
+    /**
+     * Writes the reachable states as cubes over the state bits to the given stream, one cube per line.
+     * @param out   Output stream
+     * @return Number of written cubes
+     */
+    size_t Reachability::dumpReachableStates(std::ostream &out) {
+        return dumpCubes(reachableStates(), current_states, out);
+    }
+
+    /**
+     * Enables or disables the minimization of the frontier before imaging it. States reached in earlier iterations
+     * are treated as don't cares, which often yields a smaller BDD for the image computation. The reachable states
+     * are not affected.
+     * @param enable true, to minimize the frontier using restrict
+     */
+    void Reachability::setFrontierMinimization(bool enable) {
+        frontier_minimization = enable;
+    }
+
+    /**
+     * Selects the algorithm isReachable uses. stateDistance and the other queries always rely on the forward
+     * fixpoint.
+     * @param strategy  Search strategy
+     */
+    void Reachability::setSearchStrategy(SearchStrategy strategy) {
+        search_strategy = strategy;
+    }
+
+    /**
+     * Selects the algorithm that computes the complete set of reachable states, used by the forward search of
+     * isReachable, isSetReachable, reachableStateCount and dumpReachableStates. Queries that depend on distances
+     * always rely on the breadth-first fixpoint.
+     * @param engine    Reachability engine
+     */
+    void Reachability::setReachabilityEngine(ReachabilityEngine engine) {
+        reachability_engine = engine;
+    }
+
+    /**
+     * Sets the order in which the chaining engine applies the event partitions within an iteration. The default order
+     * is the order of the state bits.
+     * @param order Permutation of the state bit indices
+     * @throws std::runtime_error if order is no permutation of the state bit indices
+     */
+    void Reachability::setChainingOrder(const std::vector<unsigned int> &order) {
+        std::vector<bool> used(current_states.size(), false);
+        if (order.size() != current_states.size())
+            throw std::runtime_error("State space and dimension of chaining order do not match.");
+        for (unsigned int index: order) {
+            if (index >= current_states.size() || used[index])
+                throw std::runtime_error("Chaining order is no permutation of the state bits.");
+            used[index] = true;
+        }
+        chaining_order = order;
+    }
+
+    /**
+     * Computes the reachable states in high density mode. Instead of the whole frontier, only a dense subset of the
+     * pending states that fits into the node budget is imaged in each step, which bounds the size of the BDDs
+     * passed to the image computation. Every pending state is imaged eventually, so the result is exact once it is
+     * complete. The traversal can be stopped early after a number of images and then reports the states reached
+     * so far.
+     * @param nodeBudget    Maximum number of nodes of the imaged subsets
+     * @param maxImages     Maximum number of image computations
+     * @return Reached and pending states
+     */
+    PartialReachability Reachability::highDensityReachability(size_t nodeBudget, unsigned int maxImages) {
+        BDD_ID tau = transitionRelation();
+        BDD_ID cs0 = initial_states;
+        PartialReachability result = {.reached=cs0, .pending=cs0, .images=0, .complete=false};
+
+        while (result.pending != False() && result.images < maxImages) {
+            BDD_ID subset = subsetHeavyBranch(result.pending, nodeBudget);
+            BDD_ID img = image(subset, tau);
+            result.images++;
+
+            BDD_ID new_states = and2(img, neg(result.reached));
+            result.reached = or2(result.reached, new_states);
+            result.pending = or2(and2(result.pending, neg(subset)), new_states);
+        }
+        result.complete = result.pending == False();
+        return result;
+    }
+
     /**
      * Creates variables for a new current and next state
      */
@@ -126,40 +523,205 @@ namespace ClassProject {
     }
 
     /**
-     * Evaluates a characteristic function of current_states for a given boolean state vector
-     * @param c             Characteristic function
+     * Discards the state of the fixpoint iteration and restarts it from the initial state
+     */
+    void Reachability::resetFixpoint() {
+        transition_relation = transitionRelation();
+        BDD_ID cs0 = initial_states;
+        fixpoint = {cs0, cs0, 0, {cs0}, false};
+        engine_complete = false;
+        distance_add_complete = false;
+        computation_required = false;
+    }
+
+    /**
+     * Decides whether the target states can reach the initial state by a fixpoint of pre-images. The iteration stops
+     * as soon as the initial state is hit.
+     * @param target    Characteristic function of the target states
+     * @return true, if a target state is reachable
+     */
+    bool Reachability::backwardSearch(BDD_ID target) {
+        BDD_ID tau = transitionRelation();
+        BDD_ID cs0 = initial_states;
+
+        BDD_ID cB = target;
+        BDD_ID frontier = target;
+        while (!intersects(frontier, cs0)) {
+            BDD_ID preB = preImage(frontier, tau);
+            // fixpoint is reached without hitting the initial state
+            if (leq(preB, cB))
+                return false;
+            frontier = and2(preB, neg(cB));
+            cB = or2(cB, frontier);
+        }
+        return true;
+    }
+
+    /**
+     * Decides whether the target states are reachable by alternating forward steps from the initial state and
+     * backward steps from the target states. The search stops as soon as the frontier of one direction hits the
+     * states reached by the other direction, or one direction reaches its fixpoint.
+     * @param target    Characteristic function of the target states
+     * @return true, if a target state is reachable
+     */
+    bool Reachability::bidirectionalSearch(BDD_ID target) {
+        BDD_ID tau = transitionRelation();
+        BDD_ID cs0 = initial_states;
+
+        BDD_ID cF = cs0, frontierF = cs0;
+        BDD_ID cB = target, frontierB = target;
+        if (intersects(cF, cB))
+            return true;
+        while (true) {
+            BDD_ID imgF = image(frontierF, tau);
+            if (leq(imgF, cF))
+                return false;   // all reachable states are known and none of them is a target state
+            frontierF = and2(imgF, neg(cF));
+            cF = or2(cF, frontierF);
+            if (intersects(frontierF, cB))
+                return true;
+
+            BDD_ID preB = preImage(frontierB, tau);
+            if (leq(preB, cB))
+                return false;   // all states that reach a target are known and the initial state is none of them
+            frontierB = and2(preB, neg(cB));
+            cB = or2(cB, frontierB);
+            if (intersects(frontierB, cF))
+                return true;
+        }
+    }
+
+    /**
+     * Checks that a set of states is a valid BDD that only depends on current state variables
+     * @param states Characteristic function of a set of states
+     * @throws std::runtime_error if states is invalid
+     */
+    void Reachability::checkStateSet(BDD_ID states) {
+        if (states >= uniqueTableSize())
+            throw std::runtime_error("Invalid state set. Invalid BDD ID found.");
+        std::set<BDD_ID> vars;
+        findVars(states, vars);
+        for (BDD_ID var: vars) {
+            if (std::find(current_states.begin(), current_states.end(), var) == current_states.end())
+                throw std::runtime_error("State set depends on variables other than the current state variables.");
+        }
+    }
+
+    /**
+     * Evaluates a characteristic function of current_states for a given boolean state vector by walking the single
+     * path selected by the state vector. No nodes are created.
+     * @param f             Characteristic function
      * @param stateVector   boolean state vector
      * @return
      */
     bool Reachability::evaluateCharacteristicFunction(BDD_ID f, const std::vector<BDD_ID> &stateVector) {
-        for (unsigned long i = 0; i < stateVector.size(); i++) {
-            BDD_ID x = current_states[i];
-            if (stateVector[i] == True())
-                f = coFactorTrue(f, x);
-            else
-                f = coFactorFalse(f, x);
+        unsigned long i = 0;
+        while (!isConstant(f)) {
+            // skip state bits f does not depend on
+            while (current_states[i] < topVar(f))
+                i++;
+            f = stateVector[i] == True() ? coFactorTrue(f) : coFactorFalse(f);
         }
         return f == True(); // convert to boolean data type
     }
 
     /**
-     * Computes the transition relation
-     * @param s     current state
-     * @param x     inputs
-     * @param sp    next current_states
+     * Returns the transition relation, the conjunction of one partition (s'i == di(s,x)) per state bit. The partitions
+     * are kept in a balanced conjunction tree, so a changed partition only requires to rebuild the conjunctions on
+     * its path to the root.
      * @return      BDD ID of transition relation
      */
-    BDD_ID Reachability::transitionRelation(std::vector<BDD_ID> &s, std::vector<BDD_ID> &x, std::vector<BDD_ID> &sp) {
+    BDD_ID Reachability::transitionRelation() {
         // with n-array transition function d(s,x)
         // tau(s,x,s') = product (s'i * di(s,x) + ~(s'i) * ~(di(s,x))) from i=1 to n.
-        BDD_ID tau = True();
-        for (unsigned long i = 0; i < s.size(); i++) {
-            BDD_ID spi = sp[i];
-            BDD_ID di = trans_function[i];
-            BDD_ID taup = or2(and2(spi, di), and2(neg(spi), neg(di)));
-            tau = and2(tau, taup);
+        unsigned long n = trans_function.size();
+        std::set<unsigned long> stale_conjunctions;
+        for (unsigned long i: stale_partitions) {
+            relation_partitions[n + i] = xnor2(next_states[i], trans_function[i]);
+            if (n + i > 1)
+                stale_conjunctions.insert((n + i) / 2);
+        }
+        stale_partitions.clear();
+        // children have larger indices than their parents, rebuild bottom-up
+        while (!stale_conjunctions.empty()) {
+            unsigned long k = *stale_conjunctions.rbegin();
+            stale_conjunctions.erase(k);
+            relation_partitions[k] = and2(relation_partitions[2 * k], relation_partitions[2 * k + 1]);
+            if (k > 1)
+                stale_conjunctions.insert(k / 2);
+        }
+        return relation_partitions[1];
+    }
+
+    /**
+     * Decomposes the transition relation into disjunctive event partitions. Partition k contains the transitions whose
+     * top changed state bit is k, i.e. state bit k changes and all state bits above it keep their values. Transitions
+     * that change no state bit are omitted, they cannot reach new states.
+     * @return Event partitions, one per state bit
+     */
+    std::vector<BDD_ID> Reachability::eventPartitions() {
+        std::vector<BDD_ID> partitions(current_states.size());
+        BDD_ID unchanged = transition_relation;
+        for (unsigned long k = 0; k < current_states.size(); k++) {
+            partitions[k] = and2(unchanged, xor2(next_states[k], current_states[k]));
+            unchanged = and2(unchanged, xnor2(next_states[k], current_states[k]));
         }
-        return tau;
+        return partitions;
+    }
+
+    /**
+     * Computes the reachable states by saturation. The event partitions are processed bottom-up: the partition of a
+     * level is fired until no new states are found, and whenever it adds states all levels below are saturated again
+     * before moving up. The result is the same as the one of the breadth-first fixpoint.
+     * @return Characteristic function of the reachable states
+     */
+    BDD_ID Reachability::saturate() {
+        std::vector<BDD_ID> partitions = eventPartitions();
+        BDD_ID reached = initial_states;
+        unsigned long bottom = partitions.size() - 1;
+        unsigned long level = bottom;
+        while (true) {
+            // fire the event of this level until a local fixpoint is reached
+            bool grown = false;
+            while (true) {
+                BDD_ID img = image(reached, partitions[level]);
+                if (leq(img, reached))
+                    break;
+                reached = or2(reached, img);
+                grown = true;
+            }
+            // new states may enable the events below, saturate them again
+            if (grown && level != bottom)
+                level = bottom;
+            else if (level == 0)
+                return reached;
+            else
+                level--;
+        }
+    }
+
+    /**
+     * Computes the reachable states by chaining. Within each iteration the event partitions are applied one after
+     * another in the chaining order, and the states reached by one partition are already imaged by the following
+     * ones. This usually requires fewer iterations than the breadth-first fixpoint and yields the same result.
+     * @return Characteristic function of the reachable states
+     */
+    BDD_ID Reachability::chain() {
+        std::vector<BDD_ID> partitions = eventPartitions();
+        BDD_ID reached = initial_states;
+        bool grown = true;
+        while (grown) {
+            grown = false;
+            for (unsigned long i = 0; i < partitions.size(); i++) {
+                unsigned long k = chaining_order.empty() ? i : chaining_order[i];
+                BDD_ID img = image(reached, partitions[k]);
+                if (!leq(img, reached)) {
+                    reached = or2(reached, img);
+                    grown = true;
+                }
+            }
+        }
+        return reached;
     }
 
     /**
@@ -193,4 +755,44 @@ namespace ClassProject {
             f = or2(coFactorTrue(f, var), coFactorFalse(f, var));
         return f;
     }
-}
\ No newline at end of file
+
+    /**
+     * Computes the image of a set of states under the transition relation
+     * @param states    Characteristic function of the current states
+     * @param tau       Transition relation
+     * @return BDD_ID of the characteristic function of the successor states over current_states
+     */
+    BDD_ID Reachability::image(BDD_ID states, BDD_ID tau) {
+        // img(s') := ∃x ∃s states(s) ⋅ τ(s, x, s');
+        BDD_ID imgsp = existentialQuantification(existentialQuantification(and2(states, tau), current_states), inputs);
+        // form img(s) by renaming of variables s' into s;
+        // img(s) = ∃s' (s == s') ⋅ img(s')
+        return existentialQuantification(and2(characteristicFunction(current_states, next_states), imgsp),
+                                         next_states);
+    }
+
+    /**
+     * Computes the pre-image of a set of states under the transition relation
+     * @param states    Characteristic function of the successor states over current_states
+     * @param tau       Transition relation
+     * @return BDD_ID of the characteristic function of the predecessor states
+     */
+    BDD_ID Reachability::preImage(BDD_ID states, BDD_ID tau) {
+        // form states(s') by renaming of variables s into s';
+        // states(s') = ∃s (s == s') ⋅ states(s)
+        BDD_ID statesp = existentialQuantification(and2(characteristicFunction(current_states, next_states), states),
+                                                   current_states);
+        // pre(s) := ∃x ∃s' τ(s, x, s') ⋅ states(s');
+        return existentialQuantification(existentialQuantification(and2(tau, statesp), next_states), inputs);
+    }
+
+    /**
+     * Checks whether two functions have a common satisfying assignment without building their conjunction
+     * @param f Function
+     * @param g Function
+     * @return true, if f * g is satisfiable
+     */
+    bool Reachability::intersects(BDD_ID f, BDD_ID g) {
+        return iteConstant(f, g, False()) != False();
+    }
+}
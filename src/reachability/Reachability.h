@@ -5,32 +5,111 @@
 
 namespace ClassProject {
 
+    /**
+     * Intermediate result of a reachability analysis that may stop before the fixpoint is reached
+     */
+    struct PartialReachability {
+        BDD_ID reached;         ///< States reached so far, an under-approximation of the reachable states
+        BDD_ID pending;         ///< Reached states whose successors have not been computed yet
+        unsigned int images;    ///< Number of computed images
+        bool complete;          ///< True, if no states are pending, i.e. reached contains all reachable states
+    };
+
+    /**
+     * State of the forward fixpoint iteration. It is kept between queries, so the iteration can be resumed.
+     */
+    struct FixpointState {
+        BDD_ID reached;             ///< States reached so far
+        BDD_ID frontier;            ///< States newly reached by the last step
+        unsigned int steps;         ///< Number of performed image steps
+        std::vector<BDD_ID> rings;  ///< Onion rings, rings[i] contains the states with distance i
+        bool converged;             ///< True, if the fixpoint is reached
+    };
+
+    /**
+     * Shortest path from the initial state to a target state
+     */
+    struct Trace {
+        std::vector<std::vector<bool>> states;  ///< Visited states, starting with an initial state, empty if unreachable
+        std::vector<std::vector<bool>> inputs;  ///< inputs[i] leads from states[i] to states[i + 1]
+    };
+
+    /**
+     * Algorithm isReachable uses to decide whether a state is reachable
+     */
+    enum class SearchStrategy {
+        Forward,        ///< Fixpoint of images from the initial state
+        Backward,       ///< Fixpoint of pre-images from the target state, stops when the initial state is hit
+        Bidirectional   ///< Alternates forward and backward steps, stops when both frontiers intersect
+    };
+
+    /**
+     * Algorithm that computes the complete set of reachable states
+     */
+    enum class ReachabilityEngine {
+        BreadthFirst,   ///< Fixpoint of images of the whole transition relation, keeps the onion rings
+        Saturation,     ///< Fires the event partitions bottom-up, each to a local fixpoint, no onion rings
+        Chaining        ///< Applies the event partitions in sequence within each iteration, no onion rings
+    };
+
     class Reachability : public ReachabilityInterface {
     private:
         Manager manager = Manager();
 
         bool computation_required = true;
+        bool frontier_minimization = false;
+        bool distance_folding = false;
+        SearchStrategy search_strategy = SearchStrategy::Forward;
+        ReachabilityEngine reachability_engine = ReachabilityEngine::BreadthFirst;
 
-        std::vector<BDD_ID> initial_states;
+        BDD_ID initial_states = False();
         std::vector<BDD_ID> trans_function;
         std::vector<BDD_ID> current_states;
         std::vector<BDD_ID> next_states;
         std::vector<BDD_ID> inputs;
 
-        std::vector<BDD_ID> iteration_results;
+        FixpointState fixpoint = {False(), False(), 0, {}, false};
+        BDD_ID transition_relation = True();
+        std::vector<BDD_ID> relation_partitions;    // balanced conjunction tree, partition i is leaf n + i
+        std::set<unsigned long> stale_partitions;
+        std::vector<unsigned int> chaining_order;
+        BDD_ID engine_states = False();
+        bool engine_complete = false;
+        ADD_ID distance_add = 0;
+        bool distance_add_complete = false;
 
         void addState();
 
         void addInput();
 
+        void resetFixpoint();
+
+        void checkStateSet(BDD_ID states);
+
         bool evaluateCharacteristicFunction(BDD_ID f, const std::vector<BDD_ID> &stateVector);
 
-        BDD_ID transitionRelation(std::vector<BDD_ID> &s, std::vector<BDD_ID> &x, std::vector<BDD_ID> &sp);
+        BDD_ID transitionRelation();
+
+        std::vector<BDD_ID> eventPartitions();
+
+        BDD_ID saturate();
+
+        BDD_ID chain();
 
         BDD_ID characteristicFunction(std::vector<BDD_ID> &a, std::vector<BDD_ID> &b);
 
         BDD_ID existentialQuantification(BDD_ID func, const std::vector<BDD_ID> &vars);
 
+        BDD_ID image(BDD_ID states, BDD_ID tau);
+
+        BDD_ID preImage(BDD_ID states, BDD_ID tau);
+
+        bool intersects(BDD_ID f, BDD_ID g);
+
+        bool backwardSearch(BDD_ID target);
+
+        bool bidirectionalSearch(BDD_ID target);
+
     public:
         Reachability(unsigned int stateSize, unsigned int inputSize = 0);
 
@@ -44,10 +123,57 @@ namespace ClassProject {
 
         int stateDistance(const std::vector<bool> &stateVector) override;
 
+        bool isReachableWithin(const std::vector<bool> &stateVector, unsigned int k);
+
+        BDD_ID reachableSetAtDepth(unsigned int k);
+
+        int checkInvariant(BDD_ID property);
+
+        void setDistanceFolding(bool enable);
+
+        ADD_ID distanceAdd();
+
+        std::map<ADD_Value, BigCount> distanceDistribution();
+
+        Trace traceTo(const std::vector<bool> &stateVector);
+
         void setTransitionFunctions(const std::vector<BDD_ID> &transitionFunctions) override;
 
         void setInitState(const std::vector<bool> &stateVector) override;
 
+        void updateTransitionFunction(unsigned int stateIndex, BDD_ID transitionFunction);
+
+        void setInitStateSet(BDD_ID states);
+
+        bool isSetReachable(BDD_ID states);
+
+        bool step();
+
+        void runUntil(unsigned int depth);
+
+        void runToFixpoint();
+
+        const FixpointState &getFixpointState();
+
+        BDD_ID reachableStates();
+
+        BigCount reachableStateCount();
+
+        std::vector<BigCount> newStatesPerIteration();
+
+        size_t dumpReachableStates(std::ostream &out);
+
+        void setFrontierMinimization(bool enable);
+
+        void setSearchStrategy(SearchStrategy strategy);
+
+        void setReachabilityEngine(ReachabilityEngine engine);
+
+        void setChainingOrder(const std::vector<unsigned int> &order);
+
+        PartialReachability highDensityReachability(size_t nodeBudget,
+                                                    unsigned int maxImages = std::numeric_limits<unsigned int>::max());
+
     };
 
 }
@@ -2,7 +2,9 @@
 #define VDSPROJECT_REACHABILITY_TESTS_H
 
 #include <gtest/gtest.h>
+#include <limits>
 #include "Reachability.h"
+#include "CircuitToReachability.hpp"
 
 using namespace ClassProject;
 
@@ -13,6 +15,29 @@ struct ReachabilityTest : testing::Test {
     std::vector<BDD_ID> transitionFunctions;
     BDD_ID s0 = stateVars.at(0);
     BDD_ID s1 = stateVars.at(1);
+
+    // transition functions of a counter on the first bits state bits, s0 being the least significant bit
+    static std::vector<BDD_ID> makeCounter(ClassProject::Reachability &fsm, size_t bits, int wrapAt = -1) {
+        return makeCounter(fsm, bits, wrapAt, fsm.True());
+    }
+
+    // the counter only counts while enable is high and wraps around to 0 after wrapAt, if it is not negative
+    static std::vector<BDD_ID> makeCounter(ClassProject::Reachability &fsm, size_t bits, int wrapAt, BDD_ID enable) {
+        std::vector<BDD_ID> s = fsm.getStates();
+        BDD_ID wrap = fsm.False();
+        if (wrapAt >= 0) {
+            wrap = fsm.True();
+            for (size_t i = 0; i < bits; i++)
+                wrap = fsm.and2(wrap, (wrapAt >> i) & 1 ? s[i] : fsm.neg(s[i]));
+        }
+        BDD_ID carry = enable;
+        std::vector<BDD_ID> transitionFunctions;
+        for (size_t i = 0; i < bits; i++) {
+            transitionFunctions.push_back(fsm.and2(fsm.xor2(s[i], carry), fsm.neg(wrap)));
+            carry = fsm.and2(s[i], carry);
+        }
+        return transitionFunctions;
+    }
 };
 
 TEST_F(ReachabilityTest, ConstructorRuntimeErrorTest) {
@@ -146,6 +171,446 @@ TEST_F(ReachabilityTest, SingleInputTest) {
     EXPECT_TRUE(fsm->isReachable({true}));
 }
 
+TEST_F(ReachabilityTest, ReachableStateCountTest) {
+    // test if the number of reachable states and of new states per iteration matches
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(2);
+    BDD_ID s0 = fsm->getStates().at(0);
+    BDD_ID s1 = fsm->getStates().at(1);
+    EXPECT_EQ(fsm->reachableStateCount(), 1);
+
+    fsm->setTransitionFunctions({fsm->neg(s0), fsm->neg(s1)});
+    EXPECT_EQ(fsm->reachableStateCount(), 2);
+
+    fsm->setTransitionFunctions({fsm->neg(s1), s0});
+    EXPECT_EQ(fsm->reachableStateCount(), 4);
+    std::vector<BigCount> expected = {1, 1, 1, 1};
+    EXPECT_EQ(fsm->newStatesPerIteration(), expected);
+}
+
+TEST_F(ReachabilityTest, DumpReachableStatesTest) {
+    // test if all reachable states are written
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(2);
+    BDD_ID s0 = fsm->getStates().at(0);
+    BDD_ID s1 = fsm->getStates().at(1);
+    fsm->setTransitionFunctions({fsm->neg(s0), fsm->neg(s1)});
+
+    std::stringstream out;
+    EXPECT_EQ(fsm->dumpReachableStates(out), 2);
+    EXPECT_EQ(out.str(), "00\n11\n");
+}
+
+TEST_F(ReachabilityTest, FrontierMinimizationTest) {
+    // test if the minimization of the frontier does not change the reachable states
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    BDD_ID x0 = fsm->getInputs().at(0);
+    // s0' = s0 xor x0; s1' = s0 and s1; s2' = s1 or (s0 and x0)
+    fsm->setTransitionFunctions({fsm->xor2(s[0], x0), fsm->and2(s[0], s[1]),
+                                 fsm->or2(s[1], fsm->and2(s[0], x0))});
+    std::vector<BigCount> expected = fsm->newStatesPerIteration();
+
+    fsm->setFrontierMinimization(true);
+    fsm->setInitState({false, false, false});
+    EXPECT_EQ(fsm->newStatesPerIteration(), expected);
+    EXPECT_EQ(fsm->reachableStateCount(), 3);
+    EXPECT_TRUE(fsm->isReachable({true, false, false}));
+    EXPECT_FALSE(fsm->isReachable({true, false, true}));
+    EXPECT_EQ(fsm->stateDistance({false, false, true}), 2);
+}
+
+TEST_F(ReachabilityTest, HighDensityReachabilityTest) {
+    // test if the high density mode reaches the same states as the breadth-first fixpoint
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(4, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    BDD_ID x0 = fsm->getInputs().at(0);
+    // 4 bit counter that counts while x0 is high
+    fsm->setTransitionFunctions(makeCounter(*fsm, 4, -1, x0));
+
+    PartialReachability partial = fsm->highDensityReachability(3, 2);
+    EXPECT_FALSE(partial.complete);
+    EXPECT_EQ(partial.images, 2);
+    EXPECT_LT(fsm->satCount(partial.reached, s.size()), 16);
+
+    PartialReachability result = fsm->highDensityReachability(3);
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.pending, fsm->False());
+    EXPECT_TRUE(fsm->leq(partial.reached, result.reached));
+    EXPECT_EQ(fsm->satCount(result.reached, s.size()), fsm->reachableStateCount());
+}
+
+TEST_F(ReachabilityTest, SearchStrategyTest) {
+    // test if all search strategies agree with the forward fixpoint
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    BDD_ID x0 = fsm->getInputs().at(0);
+    // s0' = s0 xor x0; s1' = s0 and s1; s2' = s1 or (s0 and x0)
+    fsm->setTransitionFunctions({fsm->xor2(s[0], x0), fsm->and2(s[0], s[1]),
+                                 fsm->or2(s[1], fsm->and2(s[0], x0))});
+
+    for (const std::vector<bool> &init: {std::vector<bool>{false, false, false}, std::vector<bool>{true, true, false}}) {
+        fsm->setInitState(init);
+        for (unsigned int state = 0; state < 8; state++) {
+            std::vector<bool> stateVector = {(state & 1) != 0, (state & 2) != 0, (state & 4) != 0};
+            fsm->setSearchStrategy(SearchStrategy::Forward);
+            bool expected = fsm->isReachable(stateVector);
+            fsm->setSearchStrategy(SearchStrategy::Backward);
+            EXPECT_EQ(fsm->isReachable(stateVector), expected);
+            fsm->setSearchStrategy(SearchStrategy::Bidirectional);
+            EXPECT_EQ(fsm->isReachable(stateVector), expected);
+        }
+    }
+    fsm->setSearchStrategy(SearchStrategy::Backward);
+    EXPECT_THROW(fsm->isReachable({false}), std::runtime_error);
+}
+
+TEST_F(ReachabilityTest, EarlyTerminationTest) {
+    // test if queries stop the fixpoint as soon as the state is reached and later queries resume it
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(6);
+    // 6 bit counter
+    fsm->setTransitionFunctions(makeCounter(*fsm, 6));
+
+    EXPECT_TRUE(fsm->isReachable({true, true, false, false, false, false}));
+    size_t partialSize = fsm->uniqueTableSize();
+    EXPECT_EQ(fsm->stateDistance({true, true, false, false, false, false}), 3);
+    EXPECT_EQ(fsm->stateDistance({false, true, false, false, false, false}), 2);
+    EXPECT_EQ(fsm->uniqueTableSize(), partialSize);
+
+    EXPECT_EQ(fsm->stateDistance({false, false, false, false, false, true}), 32);
+    EXPECT_TRUE(fsm->isReachable({true, true, true, true, true, true}));
+    EXPECT_EQ(fsm->reachableStateCount(), 64);
+    EXPECT_GT(fsm->uniqueTableSize(), partialSize);
+    EXPECT_EQ(fsm->newStatesPerIteration(), std::vector<BigCount>(64, 1));
+
+    // a changed initial state restarts the fixpoint
+    fsm->setInitState({false, false, false, false, false, true});
+    EXPECT_EQ(fsm->stateDistance({false, false, false, false, false, true}), 0);
+    EXPECT_EQ(fsm->stateDistance({false, false, false, false, false, false}), 32);
+}
+
+TEST_F(ReachabilityTest, FixpointStateTest) {
+    // test if the fixpoint can be advanced step by step and resumed
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3);
+    // 3 bit counter
+    fsm->setTransitionFunctions(makeCounter(*fsm, 3));
+
+    EXPECT_EQ(fsm->getFixpointState().steps, 0);
+    EXPECT_EQ(fsm->getFixpointState().rings.size(), 1);
+    EXPECT_EQ(fsm->getFixpointState().reached, fsm->getFixpointState().frontier);
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+
+    EXPECT_TRUE(fsm->step());
+    EXPECT_EQ(fsm->getFixpointState().steps, 1);
+    EXPECT_EQ(fsm->getFixpointState().rings.size(), 2);
+
+    fsm->runUntil(4);
+    EXPECT_EQ(fsm->getFixpointState().rings.size(), 5);
+    EXPECT_EQ(fsm->satCount(fsm->getFixpointState().reached, 3), 5);
+    fsm->runUntil(2);
+    EXPECT_EQ(fsm->getFixpointState().steps, 4);
+
+    fsm->runToFixpoint();
+    EXPECT_TRUE(fsm->getFixpointState().converged);
+    EXPECT_EQ(fsm->getFixpointState().rings.size(), 8);
+    EXPECT_EQ(fsm->getFixpointState().reached, fsm->True());
+    EXPECT_FALSE(fsm->step());
+    fsm->runUntil(20);
+    EXPECT_EQ(fsm->getFixpointState().steps, 8);
+
+    // a changed initial state restarts the fixpoint
+    fsm->setInitState({true, false, false});
+    EXPECT_EQ(fsm->getFixpointState().steps, 0);
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+}
+
+TEST_F(ReachabilityTest, BoundedReachabilityTest) {
+    // test if bounded queries only compute the onion rings up to the bound
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3);
+    std::vector<BDD_ID> s = fsm->getStates();
+    // 3 bit counter
+    fsm->setTransitionFunctions(makeCounter(*fsm, 3));
+
+    EXPECT_TRUE(fsm->isReachableWithin({false, false, false}, 0));
+    EXPECT_FALSE(fsm->isReachableWithin({true, false, false}, 0));
+    EXPECT_TRUE(fsm->isReachableWithin({true, true, false}, 3));
+    EXPECT_EQ(fsm->getFixpointState().steps, 3);
+    EXPECT_FALSE(fsm->isReachableWithin({false, false, true}, 3));
+    EXPECT_EQ(fsm->getFixpointState().steps, 3);
+    EXPECT_TRUE(fsm->isReachableWithin({true, true, false}, 5));
+    EXPECT_EQ(fsm->getFixpointState().steps, 3);
+    EXPECT_THROW(fsm->isReachableWithin({false}, 1), std::runtime_error);
+
+    // s0 is the least significant bit
+    BDD_ID depth1 = fsm->or2(fsm->and2(fsm->neg(s[0]), fsm->and2(fsm->neg(s[1]), fsm->neg(s[2]))),
+                             fsm->and2(s[0], fsm->and2(fsm->neg(s[1]), fsm->neg(s[2]))));
+    EXPECT_EQ(fsm->reachableSetAtDepth(1), depth1);
+    EXPECT_EQ(fsm->reachableSetAtDepth(0), fsm->getFixpointState().rings[0]);
+    EXPECT_EQ(fsm->satCount(fsm->reachableSetAtDepth(5), 3), 6);
+    EXPECT_EQ(fsm->getFixpointState().steps, 5);
+    EXPECT_EQ(fsm->reachableSetAtDepth(100), fsm->True());
+    EXPECT_TRUE(fsm->getFixpointState().converged);
+    EXPECT_EQ(fsm->reachableSetAtDepth(std::numeric_limits<unsigned int>::max()), fsm->True());
+}
+
+TEST_F(ReachabilityTest, CheckInvariantTest) {
+    // test if invariants are checked on the frontiers and stop at the first violation
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    // 3 bit counter that wraps around from 5 to 0
+    fsm->setTransitionFunctions(makeCounter(*fsm, 3, 5));
+
+    // counter never exceeds 5
+    EXPECT_EQ(fsm->checkInvariant(fsm->neg(fsm->and2(s[1], s[2]))), -1);
+    EXPECT_TRUE(fsm->getFixpointState().converged);
+    EXPECT_EQ(fsm->checkInvariant(fsm->True()), -1);
+    // counter reaches 3 after three transitions
+    EXPECT_EQ(fsm->checkInvariant(fsm->nand2(s[0], s[1])), 3);
+    EXPECT_EQ(fsm->checkInvariant(fsm->False()), 0);
+
+    // violations stop the fixpoint
+    fsm->setInitState({false, false, false});
+    EXPECT_EQ(fsm->checkInvariant(fsm->neg(s[1])), 2);
+    EXPECT_EQ(fsm->getFixpointState().steps, 2);
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+
+    // the property must be a BDD over the state variables
+    EXPECT_THROW(fsm->checkInvariant(fsm->uniqueTableSize()), std::runtime_error);
+    EXPECT_THROW(fsm->checkInvariant(fsm->getInputs()[0]), std::runtime_error);
+}
+
+TEST_F(ReachabilityTest, TraceToTest) {
+    // test if traces lead from the initial state to the target state along valid transitions
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(2, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    std::vector<BDD_ID> x = fsm->getInputs();
+    // 2 bit counter that counts only if the input is set, 3 is unreachable
+    BDD_ID enable = fsm->and2(x[0], fsm->neg(fsm->and2(s[1], fsm->neg(s[0]))));
+    fsm->setTransitionFunctions({fsm->and2(fsm->xor2(s[0], enable), fsm->neg(s[1])),
+                                 fsm->or2(s[1], fsm->and2(s[0], enable))});
+
+    Trace trace = fsm->traceTo({false, true});
+    ASSERT_EQ(trace.states.size(), 3);
+    ASSERT_EQ(trace.inputs.size(), 2);
+    EXPECT_EQ(trace.states[0], std::vector<bool>({false, false}));
+    EXPECT_EQ(trace.states[1], std::vector<bool>({true, false}));
+    EXPECT_EQ(trace.states[2], std::vector<bool>({false, true}));
+    EXPECT_EQ(trace.inputs[0], std::vector<bool>({true}));
+    EXPECT_EQ(trace.inputs[1], std::vector<bool>({true}));
+
+    trace = fsm->traceTo({false, false});
+    EXPECT_EQ(trace.states.size(), 1);
+    EXPECT_TRUE(trace.inputs.empty());
+
+    trace = fsm->traceTo({true, true});
+    EXPECT_TRUE(trace.states.empty());
+    EXPECT_TRUE(trace.inputs.empty());
+    EXPECT_THROW(fsm->traceTo({true}), std::runtime_error);
+}
+
+TEST_F(ReachabilityTest, StateSetTest) {
+    // test if sets of initial and target states are handled by a single fixpoint
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3);
+    std::vector<BDD_ID> s = fsm->getStates();
+    // shift register, s0 is shifted into s1 and s1 into s2, s0 is cleared
+    fsm->setTransitionFunctions({fsm->False(), s[0], s[1]});
+
+    EXPECT_FALSE(fsm->isSetReachable(s[2]));
+    EXPECT_TRUE(fsm->isSetReachable(fsm->neg(s[0])));
+
+    // all states with s0 = 1 and s2 = 0 are initial
+    fsm->setInitStateSet(fsm->and2(s[0], fsm->neg(s[2])));
+    EXPECT_TRUE(fsm->isReachable({true, true, false}));
+    EXPECT_TRUE(fsm->isReachable({false, false, true}));
+    EXPECT_EQ(fsm->stateDistance({true, false, false}), 0);
+    EXPECT_EQ(fsm->stateDistance({false, true, true}), 1);
+    EXPECT_EQ(fsm->stateDistance({false, false, true}), 2);
+    EXPECT_EQ(fsm->stateDistance({false, false, false}), 3);
+    EXPECT_FALSE(fsm->isReachable({true, false, true}));
+    EXPECT_EQ(fsm->reachableStateCount(), 6);
+    EXPECT_TRUE(fsm->isSetReachable(fsm->and2(s[1], s[2])));
+    EXPECT_FALSE(fsm->isSetReachable(fsm->and2(s[0], s[2])));
+    EXPECT_FALSE(fsm->isSetReachable(fsm->False()));
+
+    for (SearchStrategy strategy: {SearchStrategy::Backward, SearchStrategy::Bidirectional}) {
+        fsm->setSearchStrategy(strategy);
+        EXPECT_TRUE(fsm->isSetReachable(fsm->and2(s[1], s[2])));
+        EXPECT_FALSE(fsm->isSetReachable(fsm->and2(s[0], s[2])));
+    }
+    fsm->setSearchStrategy(SearchStrategy::Forward);
+
+    // single initial states replace the set
+    fsm->setInitState({false, false, false});
+    EXPECT_FALSE(fsm->isSetReachable(s[0]));
+
+    EXPECT_THROW(fsm->setInitStateSet(fsm->uniqueTableSize()), std::runtime_error);
+    EXPECT_THROW(fsm->setInitStateSet(fsm->getStates()[0] + 1), std::runtime_error);
+    EXPECT_THROW(fsm->isSetReachable(fsm->uniqueTableSize()), std::runtime_error);
+}
+
+TEST_F(ReachabilityTest, UpdateTransitionFunctionTest) {
+    // test if single transition functions can be replaced
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3);
+    // 3 bit counter
+    std::vector<BDD_ID> transitionFunctions = makeCounter(*fsm, 3);
+    fsm->setTransitionFunctions(transitionFunctions);
+    EXPECT_EQ(fsm->reachableStateCount(), 8);
+
+    // s2 stays low, counter wraps around after 3
+    fsm->updateTransitionFunction(2, fsm->False());
+    EXPECT_EQ(fsm->reachableStateCount(), 4);
+    EXPECT_FALSE(fsm->isReachable({false, false, true}));
+    EXPECT_EQ(fsm->stateDistance({true, true, false}), 3);
+
+    // s1 stays low, counter toggles between 0 and 1
+    fsm->updateTransitionFunction(1, fsm->False());
+    EXPECT_EQ(fsm->reachableStateCount(), 2);
+    EXPECT_FALSE(fsm->isReachable({false, true, false}));
+
+    // restoring the functions restores the reachable states
+    fsm->setTransitionFunctions(transitionFunctions);
+    EXPECT_EQ(fsm->reachableStateCount(), 8);
+    EXPECT_EQ(fsm->stateDistance({false, false, true}), 4);
+
+    EXPECT_THROW(fsm->updateTransitionFunction(3, fsm->False()), std::runtime_error);
+    EXPECT_THROW(fsm->updateTransitionFunction(0, fsm->uniqueTableSize()), std::runtime_error);
+}
+
+TEST(CircuitToReachability_Test, s27) { /* NOLINT */
+    // test if a sequential ISCAS89 netlist is loaded into a Reachability instance
+    BenchParser parser(BENCHMARK_DIR "/iscas89/s27.bench");
+    CircuitToReachability loader(parser.GetSortedCircuit());
+    std::shared_ptr<ClassProject::Reachability> fsm = loader.GetReachability();
+
+    EXPECT_EQ(loader.GetStateLabels(), std::vector<label_t>({"G5", "G6", "G7"}));
+    EXPECT_EQ(loader.GetInputLabels(), std::vector<label_t>({"G0", "G1", "G2", "G3"}));
+    EXPECT_EQ(fsm->getStates().size(), 3);
+    EXPECT_EQ(fsm->getInputs().size(), 4);
+
+    // G17 = NOT(NOR(G5, G9)) = G5 + G9
+    std::vector<BDD_ID> s = fsm->getStates();
+    EXPECT_TRUE(fsm->leq(s[0], loader.GetBddId("G17")));
+
+    EXPECT_EQ(fsm->reachableStateCount(), 6);
+    EXPECT_EQ(fsm->newStatesPerIteration(), std::vector<BigCount>({1, 4, 1}));
+    EXPECT_FALSE(fsm->isReachable({true, true, false}));
+    EXPECT_FALSE(fsm->isReachable({true, true, true}));
+    EXPECT_EQ(fsm->stateDistance({false, true, true}), 2);
+    EXPECT_EQ(fsm->stateDistance({true, false, true}), 1);
+
+    fsm->setReachabilityEngine(ReachabilityEngine::Saturation);
+    fsm->setInitState({false, false, false});
+    EXPECT_EQ(fsm->reachableStateCount(), 6);
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+
+    EXPECT_THROW(loader.GetBddId("G42"), std::runtime_error);
+}
+
+TEST_F(ReachabilityTest, SaturationTest) {
+    // test if saturation reaches the same states as the breadth-first fixpoint
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(4, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    std::vector<BDD_ID> x = fsm->getInputs();
+    // 3 bit counter on s0..s2 that counts if the input is set, s3 latches whether the counter wrapped around
+    std::vector<BDD_ID> transitionFunctions = makeCounter(*fsm, 3, -1, x[0]);
+    BDD_ID carry = fsm->and2(x[0], fsm->and2(s[0], fsm->and2(s[1], s[2])));
+    transitionFunctions.push_back(fsm->or2(s[3], carry));
+    fsm->setTransitionFunctions(transitionFunctions);
+
+    fsm->setReachabilityEngine(ReachabilityEngine::Saturation);
+    BDD_ID saturated = fsm->reachableStates();
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+    EXPECT_EQ(fsm->reachableStateCount(), 16);
+    EXPECT_TRUE(fsm->isReachable({true, false, true, true}));
+    EXPECT_TRUE(fsm->isSetReachable(s[3]));
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+
+    fsm->setReachabilityEngine(ReachabilityEngine::BreadthFirst);
+    EXPECT_EQ(fsm->reachableStates(), saturated);
+
+    // s3 is never set, if the counter stops at 4
+    fsm->updateTransitionFunction(0, fsm->and2(transitionFunctions[0], fsm->neg(s[2])));
+    fsm->setReachabilityEngine(ReachabilityEngine::Saturation);
+    saturated = fsm->reachableStates();
+    EXPECT_EQ(fsm->reachableStateCount(), 5);
+    EXPECT_FALSE(fsm->isReachable({true, false, true, false}));
+    EXPECT_FALSE(fsm->isSetReachable(s[3]));
+    fsm->setReachabilityEngine(ReachabilityEngine::BreadthFirst);
+    EXPECT_EQ(fsm->reachableStates(), saturated);
+
+    // the initial states are saturated as a set
+    fsm->setInitStateSet(fsm->and2(s[0], s[2]));
+    fsm->setReachabilityEngine(ReachabilityEngine::Saturation);
+    saturated = fsm->reachableStates();
+    fsm->setReachabilityEngine(ReachabilityEngine::BreadthFirst);
+    EXPECT_EQ(fsm->reachableStates(), saturated);
+}
+
+TEST_F(ReachabilityTest, ChainingTest) {
+    // test if chaining reaches the same states as the breadth-first fixpoint for any order
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3, 1);
+    std::vector<BDD_ID> s = fsm->getStates();
+    std::vector<BDD_ID> x = fsm->getInputs();
+    // shift register with input, s2 is the oldest bit
+    fsm->setTransitionFunctions({x[0], s[0], s[1]});
+    fsm->setInitStateSet(fsm->and2(s[0], fsm->and2(s[1], s[2])));
+
+    fsm->setReachabilityEngine(ReachabilityEngine::Chaining);
+    BDD_ID chained = fsm->reachableStates();
+    EXPECT_EQ(chained, fsm->True());
+    EXPECT_FALSE(fsm->getFixpointState().converged);
+
+    for (const std::vector<unsigned int> &order: {std::vector<unsigned int>({2, 1, 0}),
+                                                  std::vector<unsigned int>({1, 0, 2})}) {
+        fsm->setChainingOrder(order);
+        fsm->setInitState({true, false, false});
+        EXPECT_EQ(fsm->reachableStateCount(), 8);
+        EXPECT_FALSE(fsm->getFixpointState().converged);
+    }
+
+    // a one-hot token that moves from s0 to s2 and stays there
+    fsm->setTransitionFunctions({fsm->False(), s[0], fsm->or2(s[1], s[2])});
+    fsm->setInitState({true, false, false});
+    fsm->setReachabilityEngine(ReachabilityEngine::Chaining);
+    chained = fsm->reachableStates();
+    EXPECT_EQ(fsm->reachableStateCount(), 3);
+    fsm->setReachabilityEngine(ReachabilityEngine::BreadthFirst);
+    EXPECT_EQ(fsm->reachableStates(), chained);
+
+    EXPECT_THROW(fsm->setChainingOrder({0, 1}), std::runtime_error);
+    EXPECT_THROW(fsm->setChainingOrder({0, 1, 1}), std::runtime_error);
+    EXPECT_THROW(fsm->setChainingOrder({0, 1, 3}), std::runtime_error);
+}
+
+TEST_F(ReachabilityTest, DistanceAddTest) {
+    // test if the onion rings are folded into a distance ADD
+    std::unique_ptr<ClassProject::Reachability> fsm = std::make_unique<ClassProject::Reachability>(3);
+    // 3 bit counter that wraps around from 5 to 0
+    fsm->setTransitionFunctions(makeCounter(*fsm, 3, 5));
+    fsm->setDistanceFolding(true);
+
+    EXPECT_EQ(fsm->stateDistance({false, false, false}), 0);
+    EXPECT_EQ(fsm->stateDistance({true, true, false}), 3);
+    EXPECT_EQ(fsm->stateDistance({true, false, true}), 5);
+    EXPECT_EQ(fsm->stateDistance({false, true, true}), -1);
+    EXPECT_THROW(fsm->stateDistance({false}), std::runtime_error);
+    EXPECT_TRUE(fsm->getFixpointState().converged);
+
+    std::map<ADD_Value, BigCount> distribution = fsm->distanceDistribution();
+    EXPECT_EQ(distribution.size(), 7);
+    EXPECT_EQ(distribution[-1], 2);
+    for (ADD_Value distance = 0; distance < 6; distance++)
+        EXPECT_EQ(distribution[distance], 1);
+
+    // a changed initial state folds the new onion rings
+    ADD_ID add = fsm->distanceAdd();
+    fsm->setInitState({false, true, false});
+    EXPECT_NE(fsm->distanceAdd(), add);
+    EXPECT_EQ(fsm->stateDistance({false, false, false}), 4);
+    EXPECT_EQ(fsm->distanceDistribution()[-1], 2);
+
+    fsm->setDistanceFolding(false);
+    EXPECT_EQ(fsm->stateDistance({false, false, false}), 4);
+}
+
 TEST(Distance_Test, distanceExample) { /* NOLINT */
     std::unique_ptr<ClassProject::Reachability> distanceFSM = std::make_unique<ClassProject::Reachability>(2,1);
     std::vector<BDD_ID> stateVars6 = distanceFSM->getStates();
@@ -89,6 +89,60 @@ namespace ClassProject {
         EXPECT_EQ(m->ite(c, d, d), d);
     }
 
+    TEST_F(ManagerTest, iteConstant) {
+        // decides whether ite(i, t, e) is constant without creating nodes
+        EXPECT_EQ(m->iteConstant(m->True(), m->False(), a), m->False());
+        EXPECT_EQ(m->iteConstant(m->False(), m->False(), a), m->NonConstant());
+        EXPECT_EQ(m->iteConstant(a, m->True(), m->False()), m->NonConstant());
+
+        size_t size = m->uniqueTableSize();
+        EXPECT_EQ(m->iteConstant(a_and_b, a_or_b, m->True()), m->True());    // a*b -> a+b
+        EXPECT_EQ(m->iteConstant(a_or_b, a_and_b, m->True()), m->NonConstant());
+        EXPECT_EQ(m->iteConstant(a_and_b, a_nand_b, m->False()), m->False());  // a*b*~(a*b)
+        EXPECT_EQ(m->iteConstant(a_xor_b, a_xnor_b, a_xor_b), m->False());
+        EXPECT_EQ(m->iteConstant(a_xor_b, neg_a, b), m->NonConstant());
+        EXPECT_EQ(m->iteConstant(c, f1, m->True()), m->True());
+        EXPECT_EQ(m->uniqueTableSize(), size);
+    }
+
+    TEST_F(ManagerTest, leq) {
+        // returns true, if f implies g
+        EXPECT_TRUE(m->leq(m->False(), a));
+        EXPECT_TRUE(m->leq(a, m->True()));
+        EXPECT_TRUE(m->leq(a_and_b, a));
+        EXPECT_TRUE(m->leq(a_and_b, f1));
+        EXPECT_TRUE(m->leq(c_or_d, f1));
+        EXPECT_TRUE(m->leq(f1, f1));
+        EXPECT_FALSE(m->leq(a, a_and_b));
+        EXPECT_FALSE(m->leq(f1, c_or_d));
+        EXPECT_FALSE(m->leq(a_xor_b, a_xnor_b));
+    }
+
+    TEST_F(ManagerTest, constrain) {
+        // generalized co-factor, agrees with f on the care set
+        EXPECT_EQ(m->constrain(f1, m->True()), f1);
+        EXPECT_EQ(m->constrain(f1, m->False()), m->False());
+        EXPECT_EQ(m->constrain(f1, f1), m->True());
+        EXPECT_EQ(m->constrain(a_and_b, a), b);
+        EXPECT_EQ(m->constrain(f1, c_or_d), m->True());
+        EXPECT_EQ(m->constrain(b, a_xnor_b), a);  // maps b onto a
+
+        BDD_ID care = m->or2(neg_a, c);
+        EXPECT_EQ(m->and2(m->constrain(f1, care), care), m->and2(f1, care));
+    }
+
+    TEST_F(ManagerTest, restrict) {
+        // simplification with regards to a care set, without introducing new variables
+        EXPECT_EQ(m->restrict(f1, m->True()), f1);
+        EXPECT_EQ(m->restrict(f1, f1), m->True());
+        EXPECT_EQ(m->restrict(a_and_b, a), b);
+        EXPECT_EQ(m->restrict(f1, c_or_d), m->True());
+        EXPECT_EQ(m->restrict(b, a_xnor_b), b);  // a is quantified from the care set
+
+        BDD_ID care = m->or2(neg_a, c);
+        EXPECT_EQ(m->and2(m->restrict(f1, care), care), m->and2(f1, care));
+    }
+
     TEST_F(ManagerTest, coFactorTrue) {
         EXPECT_EQ(m->coFactorTrue(m->True()), m->True());
         EXPECT_EQ(m->coFactorTrue(a), m->True());
@@ -302,4 +356,227 @@ namespace ClassProject {
         m->createVar("e");
         EXPECT_EQ(m->uniqueTableSize(), size + 1);
     }
-}
\ No newline at end of file
+
+    TEST_F(ManagerTest, satCount) {
+        // returns the number of satisfying assignments over a domain of nvars variables
+        EXPECT_EQ(m->satCount(m->False(), 4), 0);
+        EXPECT_EQ(m->satCount(m->True(), 4), 16);
+        EXPECT_EQ(m->satCount(a, 1), 1);
+        EXPECT_EQ(m->satCount(a_and_b, 2), 1);
+        EXPECT_EQ(m->satCount(a_and_b, 4), 4);
+        EXPECT_EQ(m->satCount(a_xor_b, 4), 8);
+        EXPECT_EQ(m->satCount(f1, 4), 13);   // f1 = a*b+c+d
+
+        // exact beyond 64 bit
+        EXPECT_EQ(m->satCount(m->True(), 200), BigCount(1) << 200);
+        EXPECT_EQ(m->satCount(a_and_b, 200), BigCount(1) << 198);
+
+        // domain smaller than support
+        EXPECT_THROW(m->satCount(a_and_b, 1), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, satCountDouble) {
+        EXPECT_DOUBLE_EQ(m->satCountDouble(m->False(), 4), 0.0);
+        EXPECT_DOUBLE_EQ(m->satCountDouble(f1, 4), 13.0);
+        EXPECT_DOUBLE_EQ(m->satCountDouble(a_nor_b, 3), 2.0);
+        EXPECT_THROW(m->satCountDouble(f1, 3), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, satCountLog2) {
+        EXPECT_EQ(m->satCountLog2(m->False(), 4), -std::numeric_limits<double>::infinity());
+        EXPECT_DOUBLE_EQ(m->satCountLog2(f1, 4), std::log2(13.0));
+        EXPECT_DOUBLE_EQ(m->satCountLog2(a_and_b, 2000), 1998.0);
+    }
+
+    TEST_F(ManagerTest, CubeIterator) {
+        // enumerates all paths to True of f1 = a*b+c+d
+        std::vector<BDD_ID> vars = {a, b, c, d};
+        std::vector<Cube> cubes;
+        for (CubeIterator it(*m, f1, vars); it.next();)
+            cubes.push_back(it.cube());
+
+        std::vector<Cube> expected = {{0, 2, 0, 1},
+                                      {0, 2, 1, 2},
+                                      {1, 0, 0, 1},
+                                      {1, 0, 1, 2},
+                                      {1, 1, 2, 2}};
+        EXPECT_EQ(cubes, expected);
+
+        CubeIterator none(*m, m->False(), vars);
+        EXPECT_FALSE(none.next());
+        CubeIterator all(*m, m->True(), vars);
+        EXPECT_TRUE(all.next());
+        EXPECT_EQ(all.cube(), Cube(4, CUBE_DONT_CARE));
+        EXPECT_FALSE(all.next());
+
+        // variable of the function is not part of the cube variables
+        CubeIterator missing(*m, f1, {a, b});
+        EXPECT_THROW(missing.next(), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, pickOneCube) {
+        EXPECT_EQ(m->pickOneCube(a_and_b, {a, b, c}), Cube({1, 1, CUBE_DONT_CARE}));
+        EXPECT_EQ(m->pickOneCube(c_or_d, {a, b, c, d}), Cube({CUBE_DONT_CARE, CUBE_DONT_CARE, 0, 1}));
+        EXPECT_THROW(m->pickOneCube(m->False(), {a}), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, pickOneMinterm) {
+        std::vector<bool> expected = {false, false, false, true};
+        EXPECT_EQ(m->pickOneMinterm(f1, {a, b, c, d}), expected);
+        expected = {true, false};
+        EXPECT_EQ(m->pickOneMinterm(m->and2(a, neg_b), {a, b}), expected);
+        EXPECT_THROW(m->pickOneMinterm(m->False(), {a}), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, dumpCubes) {
+        std::stringstream out;
+        EXPECT_EQ(m->dumpCubes(a_xor_b, {a, b}, out), 2);
+        EXPECT_EQ(out.str(), "01\n10\n");
+    }
+
+    TEST_F(ManagerTest, subsetHeavyBranch) {
+        // under-approximation within a node budget
+        EXPECT_EQ(m->subsetHeavyBranch(f1, 10), f1);
+        EXPECT_EQ(m->subsetHeavyBranch(m->False(), 1), m->False());
+
+        BDD_ID f = m->or2(f1, m->and2(a_xor_b, m->xor2(c, d)));
+        for (size_t threshold = 1; threshold < 10; threshold++) {
+            BDD_ID subset = m->subsetHeavyBranch(f, threshold);
+            std::set<BDD_ID> nodes;
+            m->findNodes(subset, nodes);
+            EXPECT_TRUE(m->leq(subset, f));
+            EXPECT_NE(subset, m->False());
+            if (threshold >= 5) {
+                EXPECT_LE(nodes.size(), threshold);
+            }
+        }
+        // f1 = a*b+c+d, the heavy branch a = 1, b = 1 is kept
+        EXPECT_EQ(m->subsetHeavyBranch(f1, 5), a_and_b);
+        // the light branch ~a*c*d does not fit next to the heavy branch a*(b+c)
+        BDD_ID g = m->or2(m->and2(a, m->or2(b, c)), m->and2(neg_a, m->and2(c, d)));
+        EXPECT_EQ(m->subsetHeavyBranch(g, 5), m->and2(a, m->or2(b, c)));
+        EXPECT_EQ(m->subsetHeavyBranch(g, 7), g);
+        // keeping the light branch c below a = 0 makes both successors equal, no redundant node is created
+        BDD_ID h = m->or2(m->and2(a, m->or2(c, d)), m->and2(neg_a, c));
+        EXPECT_EQ(m->subsetHeavyBranch(h, 4), c);
+    }
+
+    TEST_F(ManagerTest, subsetShortPaths) {
+        EXPECT_EQ(m->subsetShortPaths(f1, 10), f1);
+        EXPECT_EQ(m->subsetShortPaths(m->True(), 1), m->True());
+
+        BDD_ID f = m->or2(f1, m->and2(a_xor_b, m->xor2(c, d)));
+        for (size_t threshold = 1; threshold < 10; threshold++) {
+            BDD_ID subset = m->subsetShortPaths(f, threshold);
+            std::set<BDD_ID> nodes;
+            m->findNodes(subset, nodes);
+            EXPECT_TRUE(m->leq(subset, f));
+            EXPECT_NE(subset, m->False());
+            if (threshold >= 5) {
+                EXPECT_LE(nodes.size(), threshold);
+            }
+        }
+        // the shortest path of a*b + c*d*~a is a*b
+        EXPECT_EQ(m->subsetShortPaths(m->or2(a_and_b, m->and2(m->and2(c, d), neg_a)), 4), a_and_b);
+    }
+
+    TEST_F(ManagerTest, addIte) {
+        ADD_ID zero = m->addConstant(0);
+        ADD_ID one = m->addConstant(1);
+        ADD_ID seven = m->addConstant(7);
+        EXPECT_EQ(m->addConstant(7), seven);
+        EXPECT_TRUE(m->addIsConstant(seven));
+        EXPECT_EQ(m->addValue(seven), 7);
+        EXPECT_EQ(m->addTopVar(seven), ADD_TERMINAL);
+
+        EXPECT_EQ(m->addIte(m->True(), one, zero), one);
+        EXPECT_EQ(m->addIte(m->False(), one, zero), zero);
+        EXPECT_EQ(m->addIte(f1, seven, seven), seven);
+
+        // a*b -> 7, ~(a*b)*(c+d) -> 1, else 0
+        ADD_ID f = m->addIte(a_and_b, seven, m->addIte(c_or_d, one, zero));
+        EXPECT_FALSE(m->addIsConstant(f));
+        EXPECT_EQ(m->addTopVar(f), a);
+        EXPECT_EQ(m->addIte(a_and_b, seven, m->addIte(c_or_d, one, zero)), f);
+        EXPECT_EQ(m->addTableSize(), 3 + 4);
+        EXPECT_EQ(m->addCoFactorFalse(m->addCoFactorTrue(f)), m->addIte(c_or_d, one, zero));
+        EXPECT_EQ(m->addCoFactorTrue(m->addCoFactorTrue(f)), seven);
+        EXPECT_EQ(m->addCoFactorTrue(seven), seven);
+
+        EXPECT_THROW(m->addValue(f), std::runtime_error);
+        EXPECT_THROW(m->addIte(m->uniqueTableSize(), one, zero), std::runtime_error);
+        EXPECT_THROW(m->addIte(a, m->addTableSize(), zero), std::runtime_error);
+        EXPECT_THROW(m->addIsConstant(m->addTableSize()), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, addEvaluate) {
+        ADD_ID f = m->addIte(a_and_b, m->addConstant(7), m->addIte(c_or_d, m->addConstant(1), m->addConstant(0)));
+        std::vector<BDD_ID> vars = {a, b, c, d};
+        EXPECT_EQ(m->addEvaluate(f, vars, {true, true, false, false}), 7);
+        EXPECT_EQ(m->addEvaluate(f, vars, {true, false, false, true}), 1);
+        EXPECT_EQ(m->addEvaluate(f, vars, {false, true, false, false}), 0);
+        EXPECT_EQ(m->addEvaluate(m->addConstant(-1), {}, {}), -1);
+        EXPECT_EQ(m->addEvaluate(m->addIte(c, m->addConstant(3), m->addConstant(4)), {c}, {false}), 4);
+
+        EXPECT_THROW(m->addEvaluate(f, {a, b, c}, {true, false, false}), std::runtime_error);
+        EXPECT_THROW(m->addEvaluate(f, vars, {true}), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, addTerminalCounts) {
+        ADD_ID f = m->addIte(a_and_b, m->addConstant(7), m->addIte(c_or_d, m->addConstant(1), m->addConstant(0)));
+        std::map<ADD_Value, BigCount> counts = m->addTerminalCounts(f, 4);
+        EXPECT_EQ(counts.size(), 3);
+        EXPECT_EQ(counts[7], 4);
+        EXPECT_EQ(counts[1], 9);
+        EXPECT_EQ(counts[0], 3);
+
+        counts = m->addTerminalCounts(m->addConstant(5), 100);
+        EXPECT_EQ(counts[5], BigCount(1) << 100);
+
+        // the domain must contain the support a, b, c, d
+        EXPECT_THROW(m->addTerminalCounts(f, 3), std::runtime_error);
+    }
+
+    TEST_F(ManagerTest, saveLoad) {
+        std::string path = (std::filesystem::temp_directory_path() / "vds_manager_test.bdd").string();
+        BDD_ID g = m->and2(a_xor_b, m->neg(c_or_d));
+        m->save({{"f1", f1}, {"g", g}, {"a", a}, {"true", m->True()}}, path);
+
+        // loading into the same manager yields the same nodes
+        size_t size = m->uniqueTableSize();
+        std::map<std::string, BDD_ID> roots = m->load(path);
+        EXPECT_EQ(roots.size(), 4);
+        EXPECT_EQ(roots["f1"], f1);
+        EXPECT_EQ(roots["g"], g);
+        EXPECT_EQ(roots["a"], a);
+        EXPECT_EQ(roots["true"], m->True());
+        EXPECT_EQ(m->uniqueTableSize(), size);
+
+        // loading into an empty manager creates the variables
+        Manager loaded;
+        roots = loaded.load(path);
+        EXPECT_EQ(loaded.getTopVarName(roots["a"]), "a");
+        BDD_ID la = roots["a"], lb = la + 1, lc = la + 2, ld = la + 3;
+        EXPECT_EQ(loaded.getTopVarName(ld), "d");
+        EXPECT_EQ(roots["f1"], loaded.or2(loaded.and2(la, lb), loaded.or2(lc, ld)));
+        EXPECT_EQ(roots["g"], loaded.and2(loaded.xor2(la, lb), loaded.nor2(lc, ld)));
+
+        // variables in a different order are matched by label
+        Manager reversed;
+        BDD_ID rd = reversed.createVar("d"), rc = reversed.createVar("c");
+        BDD_ID rb = reversed.createVar("b"), ra = reversed.createVar("a");
+        roots = reversed.load(path);
+        EXPECT_EQ(roots["a"], ra);
+        EXPECT_EQ(roots["f1"], reversed.or2(reversed.and2(ra, rb), reversed.or2(rc, rd)));
+        EXPECT_EQ(roots["g"], reversed.and2(reversed.xor2(ra, rb), reversed.nor2(rc, rd)));
+
+        // invalid files
+        EXPECT_THROW(m->save({{"x", m->uniqueTableSize()}}, path), std::runtime_error);
+        std::ofstream(path, std::ios::trunc) << "VDSBDD01\x05";
+        EXPECT_THROW(m->load(path), std::runtime_error);
+        std::ofstream(path, std::ios::trunc) << "not a BDD file";
+        EXPECT_THROW(m->load(path), std::runtime_error);
+        std::filesystem::remove(path);
+        EXPECT_THROW(m->load(path), std::runtime_error);
+    }
+}
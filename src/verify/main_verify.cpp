@@ -5,126 +5,296 @@
 #include<iostream>
 #include<fstream>
 #include<string>
-#include<sstream>
+#include<string_view>
+#include<charconv>
+#include<cstdint>
+#include<unordered_map>
+#include<unordered_set>
+#include<vector>
+#include<algorithm>
 #include<map>
+#include<atomic>
+#include<mutex>
+#include<thread>
+#include<filesystem>
+
+typedef uint64_t node_id;
 
 struct node {
-	std::string var_name;
-	int low;
-	int high;
+	std::string_view var_name;
+	node_id low;
+	node_id high;
 };
 
-typedef std::map<int, node> uniqueTable;
+typedef std::unordered_map<node_id, node> uniqueTable;
+
+struct bddFile {
+	std::string contents;	// owns the storage the variable names point into
+	uniqueTable nodes;
+	node_id root = 0;
+};
 
-bool isEquivalent(const uniqueTable &BDD1, const uniqueTable &BDD2, int root1, int root2)
+struct pairHash {
+	size_t operator()(const std::pair<node_id, node_id> &p) const
+	{
+		return std::hash<node_id>()(p.first * 0x9e3779b97f4a7c15ULL ^ p.second);
+	}
+};
+
+/* Returns the token following key in line, starting the search at pos. */
+static std::string_view fieldAfter(std::string_view line, std::string_view key, size_t &pos)
 {
-	if(BDD1.find(root1) == BDD1.end() || BDD2.find(root2) == BDD2.end())
-		return false;
-	if(root1 == 1 && root2 == 1)
-		return true;
-	if(root1 == 0 && root2 == 0)
-		return true;
-	if(root1 != root2 && ( (root1 == 0 || root1 == 1) || (root2 == 0 || root2 == 1) ) )
-		return false;
-	if(BDD1.at(root1).var_name != BDD2.at(root2).var_name)
-		return false;
-    return isEquivalent(BDD1, BDD2, BDD1.at(root1).low, BDD2.at(root2).low) and isEquivalent(BDD1, BDD2, BDD1.at(root1).high, BDD2.at(root2).high);
+	pos = line.find(key, pos);
+	if(pos == std::string_view::npos)
+		return {};
+	pos += key.size();
+	size_t end = line.find(' ', pos);
+	if(end == std::string_view::npos)
+		end = line.size();
+	std::string_view token = line.substr(pos, end - pos);
+	pos = end;
+	return token;
 }
 
-int main(int argc, char* argv[])
+static bool parseId(std::string_view token, node_id &id)
 {
+	auto result = std::from_chars(token.data(), token.data() + token.size(), id);
+	return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
 
-	/* Number of arguments validation */
-	if (3 > argc)
+/* Parses one line, returns false if it is malformed */
+static bool parseLine(std::string_view line, bddFile &bdd)
+{
+	node n;
+	node_id id;
+	size_t pos = 0;
+
+	if(line.find("Terminal Node: ") != std::string_view::npos)
 	{
-		std::cout << "Must specify a filename!" << std::endl;
-		return -1;
+		if(!parseId(fieldAfter(line, "Terminal Node: ", pos), id) || id > 1)
+			return false;
+		n.low = n.high = id;
 	}
-	
-	uniqueTable BDD1, BDD2;
+	else if(line.find("Variable Node: ") != std::string_view::npos)
+	{
+		if(!parseId(fieldAfter(line, "Variable Node: ", pos), id))
+			return false;
+		n.var_name = fieldAfter(line, " Top Var Name: ", pos);
+		if(!parseId(fieldAfter(line, " Low: ", pos), n.low) || !parseId(fieldAfter(line, " High: ", pos), n.high))
+			return false;
+	}
+	else
+		return true;
 
-	std::string BDD1_file = argv[1];
-	std::string BDD2_file = argv[2];
+	bdd.nodes.emplace(id, n);
+	if(id > bdd.root)
+		bdd.root = id;
+	return true;
+}
 
-	std::ifstream BDD1_if(BDD1_file.c_str());
-	std::ifstream BDD2_if(BDD2_file.c_str());
+static bool loadBDD(const std::string &file_name, bddFile &bdd)
+{
+	std::ifstream in(file_name, std::ios::binary | std::ios::ate);
+	if(!in.is_open())
+		return false;
+	bdd.contents.resize(static_cast<size_t>(in.tellg()));
+	in.seekg(0);
+	if(!in.read(&bdd.contents[0], bdd.contents.size()))
+		return false;
 
-	if(!BDD1_if.is_open() || !BDD2_if.is_open())
+	std::string_view text = bdd.contents;
+	/* A variable node line takes roughly 80 characters */
+	bdd.nodes.reserve(text.size() / 80 + 2);
+	while(!text.empty())
 	{
-		std::cout << "invalid file!" << std::endl;
-		return -1;
+		size_t end = text.find('\n');
+		if(end == std::string_view::npos)
+			end = text.size();
+		std::string_view line = text.substr(0, end);
+		if(!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		if(!parseLine(line, bdd))
+			return false;
+		text.remove_prefix(end == text.size() ? end : end + 1);
 	}
+	return !bdd.nodes.empty();
+}
 
-	std::stringstream ss;
-
-	std::string temp;
-	std::string var_name;
-	int id, top_var;
+/* Compares the two diagrams structurally, every pair of nodes is visited at most once */
+bool isEquivalent(const uniqueTable &BDD1, const uniqueTable &BDD2, node_id root1, node_id root2)
+{
+	std::unordered_set<std::pair<node_id, node_id>, pairHash> visited;
+	std::vector<std::pair<node_id, node_id>> stack = {{root1, root2}};
 
-	while(!BDD1_if.eof())
+	while(!stack.empty())
 	{
-		node n;			
-		temp.clear();
-		std::getline(BDD1_if, temp,'\n');
+		auto [id1, id2] = stack.back();
+		stack.pop_back();
+		if(!visited.insert({id1, id2}).second)
+			continue;
 
-		if(temp.find("Terminal Node: 1") != std::string::npos)
+		auto node1 = BDD1.find(id1);
+		auto node2 = BDD2.find(id2);
+		if(node1 == BDD1.end() || node2 == BDD2.end())
+			return false;
+		if(id1 <= 1 || id2 <= 1)
 		{
-			n.var_name = "";
-			n.low = 1;
-			n.high = 1;
-			BDD1.insert(std::pair<int,node>(1,n));
+			if(id1 != id2)
+				return false;
+			continue;
 		}
-		else if(temp.find("Terminal Node: 0") != std::string::npos)
-		{
-			n.var_name = "";
-			n.low = 0;
-			n.high = 0;
-			BDD1.insert(std::pair<int,node>(0,n));
+		if(node1->second.var_name != node2->second.var_name)
+			return false;
+		stack.emplace_back(node1->second.high, node2->second.high);
+		stack.emplace_back(node1->second.low, node2->second.low);
+	}
+	return true;
+}
 
-		}
-		else if(temp.find("Variable Node:") != std::string::npos)
+enum class verifyResult { Equivalent, NotEquivalent, Invalid, Missing };
+
+static verifyResult verifyFiles(const std::string &file1, const std::string &file2)
+{
+	bddFile BDD1, BDD2;
+
+	if(!loadBDD(file1, BDD1) || !loadBDD(file2, BDD2))
+		return verifyResult::Invalid;
+	if(isEquivalent(BDD1.nodes, BDD2.nodes, BDD1.root, BDD2.root))
+		return verifyResult::Equivalent;
+	return verifyResult::NotEquivalent;
+}
+
+/* Verifies all outputs of two result directories, matched by file name, on a pool of threads */
+static int verifyDirectories(const std::filesystem::path &dir1, const std::filesystem::path &dir2, unsigned jobs, bool fail_fast)
+{
+	std::map<std::string, verifyResult> results;
+	for(const auto &entry : std::filesystem::directory_iterator(dir1))
+		if(entry.is_regular_file())
+			results[entry.path().filename().string()] = verifyResult::Missing;
+	for(const auto &entry : std::filesystem::directory_iterator(dir2))
+		if(entry.is_regular_file())
+			results.emplace(entry.path().filename().string(), verifyResult::Missing);
+
+	std::vector<std::pair<const std::string, verifyResult>*> pairs;
+	for(auto &result : results)
+		if(std::filesystem::is_regular_file(dir1 / result.first) && std::filesystem::is_regular_file(dir2 / result.first))
+			pairs.push_back(&result);
+
+	std::atomic<size_t> next_pair{0};
+	std::atomic<bool> failed{false};
+	std::mutex report_mutex;
+	auto worker = [&]()
+	{
+		for(size_t i = next_pair++; i < pairs.size() && !(fail_fast && failed); i = next_pair++)
 		{
-			ss.clear();
-			ss.str(temp);
-			ss>>temp>>temp>>id>>temp>>temp>>temp>>top_var>>temp>>temp>>temp>>n.var_name>>temp>>n.low>>temp>>n.high;
-			BDD1.insert(std::pair<int,node>(id,n));
+			verifyResult result = verifyFiles((dir1 / pairs[i]->first).string(), (dir2 / pairs[i]->first).string());
+			pairs[i]->second = result;
+			if(result == verifyResult::Equivalent)
+				continue;
+			failed = true;
+			if(fail_fast)
+			{
+				std::lock_guard<std::mutex> lock(report_mutex);
+				std::cout << (result == verifyResult::Invalid ? "invalid file: " : "Not Equivalent: ") << pairs[i]->first << std::endl;
+			}
 		}
-	}
+	};
 
-	while(!BDD2_if.eof())
-	{
-		node n;			
-		temp.clear();
-		std::getline(BDD2_if, temp,'\n');
+	std::vector<std::thread> workers;
+	for(unsigned i = 1; i < jobs; i++)
+		workers.emplace_back(worker);
+	worker();
+	for(auto &thread : workers)
+		thread.join();
+
+	if(fail_fast && failed)
+		return 1;
 
-		if(temp.find("Terminal Node: 1") != std::string::npos)
+	size_t equivalent = 0, not_equivalent = 0, invalid = 0, missing = 0;
+	for(const auto &[name, result] : results)
+	{
+		switch(result)
 		{
-			n.var_name = "";
-			n.low = 1;
-			n.high = 1;
-			BDD2.insert(std::pair<int,node>(1,n));
+			case verifyResult::Equivalent:
+				equivalent++;
+				break;
+			case verifyResult::NotEquivalent:
+				not_equivalent++;
+				std::cout << "Not Equivalent: " << name << std::endl;
+				break;
+			case verifyResult::Invalid:
+				invalid++;
+				std::cout << "invalid file: " << name << std::endl;
+				break;
+			case verifyResult::Missing:
+				missing++;
+				std::cout << "Missing in " << (std::filesystem::exists(dir1 / name) ? dir2 : dir1).string() << ": " << name << std::endl;
+				break;
 		}
-		else if(temp.find("Terminal Node: 0") != std::string::npos)
-		{
-			n.var_name = "";
-			n.low = 0;
-			n.high = 0;
-			BDD2.insert(std::pair<int,node>(0,n));
+	}
+	std::cout << "Verified " << pairs.size() << " outputs: " << equivalent << " equivalent, "
+	          << not_equivalent << " not equivalent, " << invalid << " invalid, " << missing << " missing" << std::endl;
+	return not_equivalent + invalid + missing > 0 ? 1 : 0;
+}
 
-		}
-		else if(temp.find("Variable Node:") != std::string::npos)
+static void printUsage(const char *program)
+{
+	std::cout << "Usage: " << program << " <bdd_file1> <bdd_file2>" << std::endl
+	          << "       " << program << " <result_dir1> <result_dir2> [--jobs <n>] [--fail-fast]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+
+	/* Number of arguments validation */
+	if (3 > argc)
+	{
+		std::cout << "Must specify a filename!" << std::endl;
+		printUsage(argv[0]);
+		return -1;
+	}
+
+	if(std::filesystem::is_directory(argv[1]) && std::filesystem::is_directory(argv[2]))
+	{
+		unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+		bool fail_fast = false;
+		for(int i = 3; i < argc; i++)
 		{
-			ss.clear();
-			ss.str(temp);
-			ss>>temp>>temp>>id>>temp>>temp>>temp>>top_var>>temp>>temp>>temp>>n.var_name>>temp>>n.low>>temp>>n.high;
-			BDD2.insert(std::pair<int,node>(id,n));
+			std::string option = argv[i];
+			if(option == "--jobs")
+			{
+				std::string_view count = i + 1 < argc ? argv[++i] : "";
+				auto result = std::from_chars(count.data(), count.data() + count.size(), jobs);
+				if(result.ec != std::errc() || result.ptr != count.data() + count.size() || jobs == 0)
+				{
+					std::cout << "Invalid job count: " << count << std::endl;
+					printUsage(argv[0]);
+					return -1;
+				}
+			}
+			else if(option == "--fail-fast")
+				fail_fast = true;
+			else
+			{
+				std::cout << "Unknown option: " << option << std::endl;
+				printUsage(argv[0]);
+				return -1;
+			}
 		}
+		return verifyDirectories(argv[1], argv[2], jobs, fail_fast);
 	}
 
-	if( isEquivalent(BDD1, BDD2, BDD1.rbegin()->first, BDD2.rbegin()->first) )
-		std::cout<<"Equivalent!"<<std::endl;
-	else
-		std::cout<<"Not Equivalent!"<<std::endl;
+	switch(verifyFiles(argv[1], argv[2]))
+	{
+		case verifyResult::Equivalent:
+			std::cout<<"Equivalent!"<<std::endl;
+			break;
+		case verifyResult::NotEquivalent:
+			std::cout<<"Not Equivalent!"<<std::endl;
+			break;
+		default:
+			std::cout << "invalid file!" << std::endl;
+			return -1;
+	}
 	return 0;
 }
-